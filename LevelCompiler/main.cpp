@@ -0,0 +1,427 @@
+// LevelCompiler - bakes a text level source into the binary .lvl the game maps
+//
+//   LevelCompiler <source.txt> <output.lvl>
+//
+// The source is checked before anything is written: the goal must be reachable
+// from the spawn, every tower slot must be a rectangle of slot tiles around its
+// anchor and every slot tile must belong to a slot. The enemy path is
+// computed here so the game only has to read it.
+//
+// Source format, one directive per line, '#' starts a comment:
+//
+//   spawn <row> <col>          enemy start tile
+//   goal <row> <col>           enemy end tile
+//   base <row> <col>           main tower tile
+//   baseHealth <hp>
+//   startGold <gold>
+//   towerMax <count>
+//   stations <file>            power station pixel positions, "x y" per line,
+//                              relative to the source file
+//   wave                       starts a wave, its groups follow
+//   group <fast|ranged|heavy> <count> [cadence <s>] [delay <s>] [hp <scale>]
+//                              cadence: seconds between spawns (default: one
+//                              enemy every 120 px of its speed), delay: seconds
+//                              after the wave starts, hp: health multiplier
+//   wave <enemy> <count> [...] shorthand for a wave with a single group
+//   slot <anchorRow> <anchorCol> <flipped> <originX> <originY> <button x y> x3 <circle x y>
+//   grid <rows> <cols>         followed by rows lines of cols tiles:
+//                              '.' blocked, 'o' enemy path, 'T' tower slot
+
+#include "LevelFile.h"
+#include "cbitgrid.h"
+#include "cpoint.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct SlotSource
+    {
+        int line;
+        LevelSlot slot;
+    };
+
+    struct LevelSource
+    {
+        LevelHeader header;
+        std::vector<uint8_t> grid;
+        std::vector<SlotSource> slots;
+        std::vector<LevelStation> stations;
+        std::vector<LevelWave> waves;
+        std::vector<LevelWaveGroup> groups;
+        bool hasSpawn = false, hasGoal = false, hasBase = false, hasGrid = false;
+    };
+
+    std::string gSource; // For error messages
+
+    void fail(int line, const std::string& message)
+    {
+        std::ostringstream out;
+        out << gSource;
+        if (line > 0)
+            out << "(" << line << ")";
+        out << ": error: " << message;
+        throw std::runtime_error(out.str());
+    }
+
+    void warn(int line, const std::string& message)
+    {
+        std::cerr << gSource << "(" << line << "): warning: " << message << "\n";
+    }
+
+    std::string directoryOf(const std::string& path)
+    {
+        std::size_t slash = path.find_last_of("/\\");
+        return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+    }
+
+    bool inside(const LevelHeader& h, int row, int col)
+    {
+        return row >= 0 && row < h.rows && col >= 0 && col < h.cols;
+    }
+
+    template <typename T>
+    T read(std::istringstream& in, int line, const char* what)
+    {
+        T value;
+        if (!(in >> value))
+            fail(line, std::string("expected ") + what);
+        return value;
+    }
+
+    void readTile(std::istringstream& in, int line, int16_t& row, int16_t& col)
+    {
+        row = static_cast<int16_t>(read<int>(in, line, "row"));
+        col = static_cast<int16_t>(read<int>(in, line, "column"));
+    }
+
+    int32_t parseEnemy(const std::string& name, int line)
+    {
+        // Matches EnemyType in cenemy.h
+        if (name == "fast") return 0;
+        if (name == "ranged") return 1;
+        if (name == "heavy") return 2;
+        fail(line, "unknown enemy type '" + name + "'");
+        return -1;
+    }
+
+    void loadStations(const std::string& filename, int line, std::vector<LevelStation>& out)
+    {
+        std::ifstream in(filename);
+        if (!in)
+            fail(line, "cannot open stations file " + filename);
+
+        LevelStation s;
+        while (in >> s.x >> s.y)
+            out.push_back(s);
+        if (!in.eof())
+            fail(line, "bad station position in " + filename);
+    }
+
+    // Appends a group to the last wave
+    void readGroup(std::istringstream& in, int line, LevelSource& src)
+    {
+        LevelWaveGroup g;
+        g.enemyType = parseEnemy(read<std::string>(in, line, "enemy type"), line);
+        g.count = read<int>(in, line, "enemy count");
+        g.cadence = 0.f;
+        g.delay = 0.f;
+        g.hpScale = 1.f;
+        if (g.count <= 0)
+            fail(line, "group needs at least one enemy");
+
+        std::string option;
+        while (in >> option)
+        {
+            if (option == "cadence") g.cadence = read<float>(in, line, "cadence seconds");
+            else if (option == "delay") g.delay = read<float>(in, line, "delay seconds");
+            else if (option == "hp") g.hpScale = read<float>(in, line, "health scale");
+            else fail(line, "unknown group option '" + option + "'");
+        }
+        if (g.cadence < 0.f || g.delay < 0.f)
+            fail(line, "cadence and delay cannot be negative");
+        if (g.hpScale <= 0.f)
+            fail(line, "health scale must be positive");
+
+        src.groups.push_back(g);
+        src.waves.back().groupCount++;
+    }
+
+    LevelSource parse(const std::string& filename)
+    {
+        std::ifstream in(filename);
+        if (!in)
+            fail(0, "cannot open source file");
+
+        LevelSource src;
+        std::memset(&src.header, 0, sizeof(src.header));
+        LevelHeader& h = src.header;
+
+        std::string text;
+        int line = 0;
+        while (std::getline(in, text))
+        {
+            ++line;
+            std::size_t hash = text.find('#');
+            if (hash != std::string::npos)
+                text.erase(hash);
+
+            std::istringstream words(text);
+            std::string key;
+            if (!(words >> key))
+                continue;
+
+            if (key == "spawn") { readTile(words, line, h.spawnRow, h.spawnCol); src.hasSpawn = true; }
+            else if (key == "goal") { readTile(words, line, h.goalRow, h.goalCol); src.hasGoal = true; }
+            else if (key == "base") { readTile(words, line, h.baseRow, h.baseCol); src.hasBase = true; }
+            else if (key == "baseHealth") h.baseHealth = read<int>(words, line, "health");
+            else if (key == "startGold") h.startGold = read<int>(words, line, "gold");
+            else if (key == "towerMax") h.towerMax = read<int>(words, line, "tower count");
+            else if (key == "stations")
+            {
+                std::string file;
+                std::getline(words >> std::ws, file);
+                while (!file.empty() && (file.back() == ' ' || file.back() == '\t' || file.back() == '\r'))
+                    file.pop_back();
+                if (file.empty())
+                    fail(line, "expected stations file");
+                loadStations(directoryOf(filename) + file, line, src.stations);
+            }
+            else if (key == "wave")
+            {
+                LevelWave w = { (uint32_t)src.groups.size(), 0 };
+                src.waves.push_back(w);
+                words >> std::ws;
+                if (!words.eof())
+                    readGroup(words, line, src);
+            }
+            else if (key == "group")
+            {
+                if (src.waves.empty())
+                    fail(line, "group before the first wave");
+                readGroup(words, line, src);
+            }
+            else if (key == "slot")
+            {
+                SlotSource s;
+                std::memset(&s.slot, 0, sizeof(s.slot));
+                s.line = line;
+                readTile(words, line, s.slot.anchorRow, s.slot.anchorCol);
+                s.slot.flipped = read<int>(words, line, "flipped flag") != 0;
+                s.slot.towerOriginX = read<float>(words, line, "tower origin x");
+                s.slot.towerOriginY = read<float>(words, line, "tower origin y");
+                if (s.slot.towerOriginX <= 0.f || s.slot.towerOriginY <= 0.f)
+                    fail(line, "tower origin divisors must be positive");
+                for (int b = 0; b < 4; ++b)
+                {
+                    s.slot.buttons[b][0] = read<float>(words, line, "button x");
+                    s.slot.buttons[b][1] = read<float>(words, line, "button y");
+                }
+                src.slots.push_back(s);
+            }
+            else if (key == "grid")
+            {
+                if (src.hasGrid)
+                    fail(line, "grid given twice");
+                int rows = read<int>(words, line, "grid rows");
+                int cols = read<int>(words, line, "grid columns");
+                if (rows != cpoint::MAP_ROW || cols != cpoint::MAP_COL)
+                    fail(line, "grid must be " + std::to_string(cpoint::MAP_ROW) + " x " + std::to_string(cpoint::MAP_COL));
+                h.rows = static_cast<uint16_t>(rows);
+                h.cols = static_cast<uint16_t>(cols);
+                src.grid.assign(rows * cols, 0);
+
+                for (int r = 0; r < rows; ++r)
+                {
+                    if (!std::getline(in, text))
+                        fail(line, "grid ends after " + std::to_string(r) + " rows");
+                    ++line;
+                    if (!text.empty() && text.back() == '\r')
+                        text.pop_back();
+                    if ((int)text.size() != cols)
+                        fail(line, "grid row must have " + std::to_string(cols) + " tiles");
+
+                    for (int c = 0; c < cols; ++c)
+                    {
+                        switch (text[c])
+                        {
+                        case '.': break;
+                        case 'o': src.grid[r * cols + c] = TILE_WALKABLE; break;
+                        case 'T': src.grid[r * cols + c] = TILE_BUILDABLE; break;
+                        default: fail(line, std::string("unknown tile '") + text[c] + "'");
+                        }
+                    }
+                }
+                src.hasGrid = true;
+            }
+            else
+                fail(line, "unknown directive '" + key + "'");
+        }
+
+        if (!src.hasGrid) fail(0, "missing grid");
+        if (!src.hasSpawn) fail(0, "missing spawn");
+        if (!src.hasGoal) fail(0, "missing goal");
+        if (!src.hasBase) fail(0, "missing base");
+        if (src.waves.empty()) fail(0, "level has no waves");
+        for (std::size_t i = 0; i < src.waves.size(); ++i)
+            if (src.waves[i].groupCount == 0)
+                fail(0, "wave " + std::to_string(i + 1) + " has no groups");
+        if (h.baseHealth <= 0) fail(0, "baseHealth must be positive");
+        return src;
+    }
+
+    // Footprint of every slot = the rectangle of slot tiles connected to its anchor
+    void deriveSlots(LevelSource& src, const cbitgrid& buildable)
+    {
+        const LevelHeader& h = src.header;
+        if (src.slots.size() > (std::size_t)LevelFile::MAX_SLOTS)
+            fail(src.slots.back().line, "more than " + std::to_string(LevelFile::MAX_SLOTS) + " tower slots");
+        if (h.towerMax <= 0 || h.towerMax > (int)src.slots.size())
+            fail(0, "towerMax must be between 1 and the number of slots");
+
+        cbitgrid covered;
+        for (SlotSource& s : src.slots)
+        {
+            LevelSlot& slot = s.slot;
+            if (!inside(h, slot.anchorRow, slot.anchorCol) || !buildable.test(slot.anchorRow, slot.anchorCol))
+                fail(s.line, "slot anchor is not on a tower slot tile");
+            if (covered.test(slot.anchorRow, slot.anchorCol))
+                fail(s.line, "slot anchor lies in the footprint of another slot");
+
+            cbitgrid footprint = buildable.floodFill(cpoint(slot.anchorRow, slot.anchorCol));
+            int top = h.rows, left = h.cols, bottom = -1, right = -1;
+            for (int r = 0; r < h.rows; ++r)
+                for (int c = 0; c < h.cols; ++c)
+                    if (footprint.test(r, c))
+                    {
+                        top = std::min(top, r); bottom = std::max(bottom, r);
+                        left = std::min(left, c); right = std::max(right, c);
+                        covered.set(r, c, true);
+                    }
+
+            if (footprint.count() != (bottom - top + 1) * (right - left + 1))
+                fail(s.line, "slot footprint is not a rectangle");
+
+            slot.top = static_cast<int16_t>(top);
+            slot.left = static_cast<int16_t>(left);
+            slot.bottom = static_cast<int16_t>(bottom);
+            slot.right = static_cast<int16_t>(right);
+        }
+
+        for (int r = 0; r < h.rows; ++r)
+            for (int c = 0; c < h.cols; ++c)
+                if (buildable.test(r, c) && !covered.test(r, c))
+                    fail(0, "tower slot tile (" + std::to_string(r) + ", " + std::to_string(c) + ") belongs to no slot");
+    }
+
+    uint32_t align4(uint32_t n)
+    {
+        return (n + 3) & ~3u;
+    }
+
+    void compile(const std::string& sourceFile, const std::string& outputFile)
+    {
+        gSource = sourceFile;
+        LevelSource src = parse(sourceFile);
+        LevelHeader& h = src.header;
+
+        cbitgrid walkable, buildable;
+        for (int r = 0; r < h.rows; ++r)
+            for (int c = 0; c < h.cols; ++c)
+            {
+                walkable.set(r, c, (src.grid[r * h.cols + c] & TILE_WALKABLE) != 0);
+                buildable.set(r, c, (src.grid[r * h.cols + c] & TILE_BUILDABLE) != 0);
+            }
+
+        // Route
+        cpoint spawn(h.spawnRow, h.spawnCol), goal(h.goalRow, h.goalCol);
+        if (!inside(h, h.spawnRow, h.spawnCol) || !walkable.test(h.spawnRow, h.spawnCol))
+            fail(0, "spawn is not on an enemy path tile");
+        if (!inside(h, h.goalRow, h.goalCol) || !walkable.test(h.goalRow, h.goalCol))
+            fail(0, "goal is not on an enemy path tile");
+        if (!inside(h, h.baseRow, h.baseCol))
+            fail(0, "base is outside the grid");
+        if (h.spawnRow < 1)
+            fail(0, "spawn needs a row above it");
+
+        std::vector<cpoint> route(h.rows * h.cols);
+        int routeLength = walkable.shortestPath(spawn, goal, route.data(), (int)route.size());
+        if (routeLength == 0)
+            fail(0, "goal cannot be reached from the spawn");
+
+        int stray = walkable.count() - walkable.floodFill(spawn).count();
+        if (stray > 0)
+            warn(0, std::to_string(stray) + " enemy path tiles cannot be reached from the spawn");
+
+        deriveSlots(src, buildable);
+
+        // Layout
+        std::memcpy(h.magic, "TDLV", 4);
+        h.version = LevelFile::VERSION;
+        uint32_t offset = sizeof(LevelHeader);
+        h.gridOffset = offset;          offset += align4(h.rows * h.cols);
+        h.slotOffset = offset;          h.slotCount = (uint32_t)src.slots.size();       offset += h.slotCount * sizeof(LevelSlot);
+        h.stationOffset = offset;       h.stationCount = (uint32_t)src.stations.size(); offset += h.stationCount * sizeof(LevelStation);
+        h.waveOffset = offset;          h.waveCount = (uint32_t)src.waves.size();       offset += h.waveCount * sizeof(LevelWave);
+        h.pathOffset = offset;          h.pathCount = (uint32_t)routeLength;            offset += h.pathCount * sizeof(LevelPathTile);
+        h.groupOffset = offset;         h.groupCount = (uint32_t)src.groups.size();     offset += h.groupCount * sizeof(LevelWaveGroup);
+        h.fileSize = offset;
+
+        std::vector<unsigned char> out(offset, 0);
+        std::memcpy(&out[0], &h, sizeof(h));
+        std::memcpy(&out[h.gridOffset], src.grid.data(), src.grid.size());
+        for (std::size_t i = 0; i < src.slots.size(); ++i)
+            std::memcpy(&out[h.slotOffset + i * sizeof(LevelSlot)], &src.slots[i].slot, sizeof(LevelSlot));
+        if (!src.stations.empty())
+            std::memcpy(&out[h.stationOffset], src.stations.data(), src.stations.size() * sizeof(LevelStation));
+        std::memcpy(&out[h.waveOffset], src.waves.data(), src.waves.size() * sizeof(LevelWave));
+        std::memcpy(&out[h.groupOffset], src.groups.data(), src.groups.size() * sizeof(LevelWaveGroup));
+        for (int i = 0; i < routeLength; ++i)
+        {
+            LevelPathTile t = { (int16_t)route[i].getRow(), (int16_t)route[i].getCol() };
+            std::memcpy(&out[h.pathOffset + i * sizeof(LevelPathTile)], &t, sizeof(t));
+        }
+
+        std::ofstream file(outputFile, std::ios::binary | std::ios::trunc);
+        if (!file.write(reinterpret_cast<const char*>(out.data()), out.size()))
+            throw std::runtime_error(outputFile + ": error: cannot write output");
+        file.close();
+
+        // Read it back the way the game does
+        LevelFile check;
+        check.open(outputFile);
+
+        std::cout << outputFile << ": " << h.slotCount << " slots, " << h.waveCount << " waves (" << h.groupCount << " groups), "
+            << h.stationCount << " stations, path " << routeLength << " tiles\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3)
+    {
+        std::cerr << "usage: LevelCompiler <source.txt> <output.lvl>\n";
+        return 2;
+    }
+
+    try
+    {
+        compile(argv[1], argv[2]);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << "\n";
+        std::remove(argv[2]);
+        return 1;
+    }
+
+    return 0;
+}
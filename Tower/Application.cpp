@@ -10,6 +10,7 @@
 #include "MapSelectionState.h"
 #include "InputNameState.h"
 #include "SaveManagement.h"
+#include "LoadingState.h"
 
 Application::Application()
     : mWindow(sf::VideoMode(1920, 1080), "Tower Defense")
@@ -17,158 +18,197 @@ Application::Application()
     , mFonts()
     , mPlayer()
     // Initialize StateStack with the application context (window, resources, audio, settings)
-    , mStateStack(State::Context(mWindow, mTextures, mFonts, mPlayer, mVictoryStars, mSoundBuffers, mMusics, isMusicOn, isSoundOn, currentMusic))
+    , mStateStack(State::Context(mWindow, mTextures, mFonts, mPlayer, mVictoryStars, mSoundBuffers, mMusics, isMusicOn, isSoundOn, currentMusic, restartLevel, mLoader))
 {
     mWindow.setVerticalSyncEnabled(true); // Smoother rendering
 
-    registerStates();
-    mStateStack.pushState(States::Menu); // Start with menu screen
-
-    // Load fonts
+    // Fonts are needed by the loading screen itself, the rest streams behind it
     mFonts.load(Fonts::BruceForever, "Media/Fonts/BruceForeverRegular-X3jd2.ttf");
     mFonts.load(Fonts::KnightWarrior, "Media/Fonts/KnightWarrior-w16n8.otf");
     mFonts.load(Fonts::RobotTraffic, "Media/Fonts/RobotTrafficDemo-BLPlw.ttf");
+    mMusics.open(Musics::MusicGame, "Audio/MusicGame.wav");
+    mMusics.open(Musics::MusicMenu, "Audio/MusicMenu.wav");
+
+    queueAssets();
 
-    // Load map textures
-    mTextures.load(Textures::Map1, "Media/Textures/map 1.png");
-    mTextures.load(Textures::Map2, "Media/Textures/map 2.png");
-    mTextures.load(Textures::Map3, "Media/Textures/map 3.png");
-    mTextures.load(Textures::Map4, "Media/Textures/map 4.png");
-
-    // Load tower textures
-    mTextures.load(Textures::MainTower, "Media/Textures/mainTower.png");
-    mTextures.load(Textures::Tower1, "Media/Textures/tower 1.png");
-    mTextures.load(Textures::Tower2, "Media/Textures/tower 2.png");
-    mTextures.load(Textures::Tower3, "Media/Textures/tower 3.png");
-    mTextures.load(Textures::Tower1plus, "Media/Textures/tower 1 - upgraded.png");
-    mTextures.load(Textures::Tower2plus, "Media/Textures/tower 2 - upgraded.png");
-    mTextures.load(Textures::Tower3plus, "Media/Textures/tower 3 - upgraded.png");
+    registerStates();
+    mStateStack.pushState(States::Loading); // Shows progress until the menu's assets are in
+}
+
+// Queues every texture and sound in the order they are first needed. Images and
+// sounds are decoded on every core; textures are uploaded between frames by
+// update(), or at once when a state requires a tier that is not in yet.
+// Full-screen backgrounds only one state draws are declared instead: they
+// load on first use and are evicted once unused and over budget. The map
+// selection screen's are decoded ahead, the rest load when opened.
+void Application::queueAssets()
+{
+    mTextures.setMemoryBudget(16 << 20); // About two unused full-screen backgrounds
+
+    // Tier Menu: the menu and the panels that open over it
+    mTextures.load(mLoader, Textures::MenuScreen, "Media/Textures/menuScreen.png");
+    mTextures.load(mLoader, Textures::newGameButton, "Media/UI/buttons/newGameButton.png");
+    mTextures.load(mLoader, Textures::loadGameButton, "Media/UI/buttons/loadGameButton.png");
+    mTextures.load(mLoader, Textures::exitButton, "Media/UI/buttons/exitButton.png");
+    mSoundBuffers.load(mLoader, SoundBuffers::UIclick, "Audio/UIclick.wav");
+
+    // Load UI in SettingState
+    mTextures.load(mLoader, Textures::settingButton, "Media/UI/buttons/settingButton.png");
+    mTextures.declare(Textures::optionsPanelInMenu, "Media/UI/optionsPanel.png");
+    mTextures.load(mLoader, Textures::onButton, "Media/UI/buttons/onButton.png");
+    mTextures.load(mLoader, Textures::offButton, "Media/UI/buttons/offButton.png");
+    mTextures.load(mLoader, Textures::closeButton, "Media/UI/buttons/xButton.png");
+
+    // Load UI in InformationState
+    mTextures.load(mLoader, Textures::infoButton, "Media/UI/buttons/informationButton.png");
+    mTextures.declare(Textures::infoPanel, "Media/UI/informationPanelInMenuState.png");
+
+    // Rasterize the glyphs of every size the states draw, so none pays for it on its first frame
+    mLoader.enqueue([] {}, [this] {
+        mFonts.prewarm(Fonts::BruceForever, 40);              // Map selection waves, invalid name
+        mFonts.prewarm(Fonts::KnightWarrior, 24);             // Information text
+    });
+    mLoader.endTier(Assets::Menu);
+
+    // Tier MapSelection: name input, saved games and the map thumbnails
+    mTextures.declare(Textures::inputNameBackground, "Media/Textures/inputNameBackground.png");
+    mTextures.load(mLoader, Textures::nextButton, "Media/UI/buttons/nextButton.png");
+
+    // Load UI in SaveMangement for Loading
+    mTextures.declare(Textures::loadBackground, "Media/UI/loadBackground.png");
+    mTextures.load(mLoader, Textures::nameBar, "Media/UI/buttons/nameBar.png");
+
+    // Load UI in MapSelectionState
+    mTextures.declare(mLoader, Textures::mapSelectionBackground, "Media/UI/MapSelectionStateBackground.png");
+    mTextures.load(mLoader, Textures::homeButton, "Media/UI/buttons/homeButton.png");
+    mTextures.declare(mLoader, Textures::miniMap1, "Media/UI/miniMapUnlocked/miniMap1.png");
+    mTextures.declare(mLoader, Textures::miniMap2, "Media/UI/miniMapUnlocked/miniMap2.png");
+    mTextures.declare(mLoader, Textures::miniMap3, "Media/UI/miniMapUnlocked/miniMap3.png");
+    mTextures.declare(mLoader, Textures::miniMap4, "Media/UI/miniMapUnlocked/miniMap4.png");
+    mTextures.declare(mLoader, Textures::miniMap2Locked, "Media/UI/miniMapLocked/miniMap2Locked.png");
+    mTextures.declare(mLoader, Textures::miniMap3Locked, "Media/UI/miniMapLocked/miniMap3Locked.png");
+    mTextures.declare(mLoader, Textures::miniMap4Locked, "Media/UI/miniMapLocked/miniMap4Locked.png");
+    mTextures.load(mLoader, Textures::wave, "Media/UI/icons/wave.png");
+    mTextures.load(mLoader, Textures::star, "Media/UI/icons/star.png");
+
+    mLoader.enqueue([] {}, [this] {
+        mFonts.prewarm(Fonts::BruceForever, 50);              // Map selection player name
+        mFonts.prewarm(Fonts::BruceForever, 70);              // Name input
+        mFonts.prewarm(Fonts::RobotTraffic, 40);              // Saved names
+    });
+    mLoader.endTier(Assets::MapSelection);
+
+    // Tier Game: everything GameState and the states over it use
+    // Load map textures, only the level being played stays resident
+    mTextures.declare(Textures::Map1, "Media/Textures/map 1.png");
+    mTextures.declare(Textures::Map2, "Media/Textures/map 2.png");
+    mTextures.declare(Textures::Map3, "Media/Textures/map 3.png");
+    mTextures.declare(Textures::Map4, "Media/Textures/map 4.png");
+
+    // Load tower textures, resampled to the scale towers are drawn at. They stay
+    // standalone: GameState tells tower kinds apart by texture
+    const SheetFormat towerFormat{ sf::Vector2u(), sf::Vector2u(1, 1), GameConstants::TOWER_SCALE };
+    mTextures.load(mLoader, Textures::MainTower, "Media/Textures/mainTower.png");
+    mTextures.load(mLoader, Textures::Tower1, "Media/Textures/tower 1.png", towerFormat);
+    mTextures.load(mLoader, Textures::Tower2, "Media/Textures/tower 2.png", towerFormat);
+    mTextures.load(mLoader, Textures::Tower3, "Media/Textures/tower 3.png", towerFormat);
+    mTextures.load(mLoader, Textures::Tower1plus, "Media/Textures/tower 1 - upgraded.png", towerFormat);
+    mTextures.load(mLoader, Textures::Tower2plus, "Media/Textures/tower 2 - upgraded.png", towerFormat);
+    mTextures.load(mLoader, Textures::Tower3plus, "Media/Textures/tower 3 - upgraded.png", towerFormat);
 
     // Load effect textures
-    mTextures.load(Textures::BombShootEffect, "Media/Textures/BombShootEffect.png");
-    mTextures.load(Textures::FireShootEffect, "Media/Textures/FireShootEffect.png");
-    mTextures.load(Textures::IceShootEffect, "Media/Textures/IceShootEffect.png");
+    mTextures.pack(mLoader, Textures::BombShootEffect, "Media/Textures/BombShootEffect.png", sf::Vector2u(30 * 5, 23));
+    mTextures.pack(mLoader, Textures::FireShootEffect, "Media/Textures/FireShootEffect.png", sf::Vector2u(30 * 5, 23));
+    mTextures.pack(mLoader, Textures::IceShootEffect, "Media/Textures/IceShootEffect.png", sf::Vector2u(30 * 5, 23));
 
     // Load tower infos
-    mTextures.load(Textures::Info1, "Media/Textures/infotower1.png");
-    mTextures.load(Textures::Info2, "Media/Textures/infotower2.png");
-    mTextures.load(Textures::Info3, "Media/Textures/infotower3.png");
-    mTextures.load(Textures::Info1plus, "Media/Textures/infotower1+.png");
-    mTextures.load(Textures::Info2plus, "Media/Textures/infotower2+.png");
-    mTextures.load(Textures::Info3plus, "Media/Textures/infotower3+.png");
+    mTextures.load(mLoader, Textures::Info1, "Media/Textures/infotower1.png");
+    mTextures.load(mLoader, Textures::Info2, "Media/Textures/infotower2.png");
+    mTextures.load(mLoader, Textures::Info3, "Media/Textures/infotower3.png");
+    mTextures.load(mLoader, Textures::Info1plus, "Media/Textures/infotower1+.png");
+    mTextures.load(mLoader, Textures::Info2plus, "Media/Textures/infotower2+.png");
+    mTextures.load(mLoader, Textures::Info3plus, "Media/Textures/infotower3+.png");
 
     // Load bullet sprites
-    mTextures.load(Textures::Bomb, "Media/Textures/bomb_sprite_sheet.png");
-    mTextures.load(Textures::Fire, "Media/Textures/fire_bullet_sprite_sheet.png");
-    mTextures.load(Textures::Ice, "Media/Textures/ice_bullet_sprite_sheet.png");
+    mTextures.pack(mLoader, Textures::Bomb, "Media/Textures/bomb_sprite_sheet.png");
+    mTextures.pack(mLoader, Textures::Fire, "Media/Textures/fire_bullet_sprite_sheet.png", // Drawn at a tenth of its 1667x1167 frames
+        SheetFormat{ sf::Vector2u(1667, 1167), sf::Vector2u(4, 1), GameConstants::FIRE_BULLET_SCALE });
+    mTextures.pack(mLoader, Textures::Ice, "Media/Textures/ice_bullet_sprite_sheet.png");
 
     // Load enemy animation textures
-    mTextures.load(Textures::Enemy1_Walk, "Media/Textures/enemy_1_walk_126_123_6.png");
-    mTextures.load(Textures::Enemy1_Attack, "Media/Textures/enemy_1_attack_125_125_6.png");
-    mTextures.load(Textures::Enemy1_Death, "Media/Textures/enemy_1_death_125_125_6.png");
-    mTextures.load(Textures::Enemy2_Fly, "Media/Textures/enemy_2_fly_209_203_4.png");
-    mTextures.load(Textures::Enemy2_Attack, "Media/Textures/enemy_2_attack_209_203_6.png");
-    mTextures.load(Textures::Enemy2_Death, "Media/Textures/enemy_2_death_209_203_6.png");
-    mTextures.load(Textures::Enemy3_Walk, "Media/Textures/enemy_3_walk_213_211_6.png");
-    mTextures.load(Textures::Enemy3_Attack, "Media/Textures/enemy_3_attack_212_210_6.png");
-    mTextures.load(Textures::Enemy3_Death, "Media/Textures/enemy_3_death_212_210_6.png");
+    mTextures.pack(mLoader, Textures::Enemy1_Walk, "Media/Textures/enemy_1_walk_126_123_6.png", sf::Vector2u(126 * 6, 123));
+    mTextures.pack(mLoader, Textures::Enemy1_Attack, "Media/Textures/enemy_1_attack_125_125_6.png", sf::Vector2u(125 * 6, 125));
+    mTextures.pack(mLoader, Textures::Enemy1_Death, "Media/Textures/enemy_1_death_125_125_6.png", sf::Vector2u(125 * 6, 125));
+    const float enemyScale = GameConstants::SMALL_ENEMY_SCALE;
+    mTextures.pack(mLoader, Textures::Enemy2_Fly, "Media/Textures/enemy_2_fly_209_203_4.png", SheetFormat{ sf::Vector2u(209, 203), sf::Vector2u(4, 1), enemyScale });
+    mTextures.pack(mLoader, Textures::Enemy2_Attack, "Media/Textures/enemy_2_attack_209_203_6.png", SheetFormat{ sf::Vector2u(209, 203), sf::Vector2u(6, 1), enemyScale });
+    mTextures.pack(mLoader, Textures::Enemy2_Death, "Media/Textures/enemy_2_death_209_203_6.png", SheetFormat{ sf::Vector2u(209, 203), sf::Vector2u(6, 1), enemyScale });
+    mTextures.pack(mLoader, Textures::Enemy3_Walk, "Media/Textures/enemy_3_walk_213_211_6.png", SheetFormat{ sf::Vector2u(213, 211), sf::Vector2u(6, 1), enemyScale });
+    mTextures.pack(mLoader, Textures::Enemy3_Attack, "Media/Textures/enemy_3_attack_212_210_6.png", SheetFormat{ sf::Vector2u(212, 210), sf::Vector2u(6, 1), enemyScale });
+    mTextures.pack(mLoader, Textures::Enemy3_Death, "Media/Textures/enemy_3_death_212_210_6.png", SheetFormat{ sf::Vector2u(212, 210), sf::Vector2u(6, 1), enemyScale });
 
     // Load functional buttons
-    mTextures.load(Textures::upgradeButton75, "Media/UI/buttons/upgradeButton75.png");
-    mTextures.load(Textures::upgradeButton100, "Media/UI/buttons/upgradeButton100.png");
-    mTextures.load(Textures::upgradeButton125, "Media/UI/buttons/upgradeButton125.png");
-    mTextures.load(Textures::sellButton, "Media/UI/buttons/SellButton.png");
+    mTextures.load(mLoader, Textures::upgradeButton75, "Media/UI/buttons/upgradeButton75.png");
+    mTextures.load(mLoader, Textures::upgradeButton100, "Media/UI/buttons/upgradeButton100.png");
+    mTextures.load(mLoader, Textures::upgradeButton125, "Media/UI/buttons/upgradeButton125.png");
+    mTextures.load(mLoader, Textures::sellButton, "Media/UI/buttons/SellButton.png");
 
     // Load construction icon
-    mTextures.load(Textures::constructionicon, "Media/Textures/ConstructionIcon.png");
-
-    // Load UI in MenuState
-    mTextures.load(Textures::MenuScreen, "Media/Textures/menuScreen.png");
-    mTextures.load(Textures::newGameButton, "Media/UI/buttons/newGameButton.png");
-    mTextures.load(Textures::loadGameButton, "Media/UI/buttons/loadGameButton.png");
-    mTextures.load(Textures::exitButton, "Media/UI/buttons/exitButton.png");
-
-    // Load UI in SettingState
-    mTextures.load(Textures::settingButton, "Media/UI/buttons/settingButton.png");
-    mTextures.load(Textures::optionsPanelInMenu, "Media/UI/optionsPanel.png");
-    mTextures.load(Textures::onButton, "Media/UI/buttons/onButton.png");
-    mTextures.load(Textures::offButton, "Media/UI/buttons/offButton.png");
-    mTextures.load(Textures::closeButton, "Media/UI/buttons/xButton.png");
-
-    // Load UI in InformationState
-    mTextures.load(Textures::infoButton, "Media/UI/buttons/informationButton.png");
-    mTextures.load(Textures::infoPanel, "Media/UI/informationPanelInMenuState.png");
-
-    // Load UI in MapSelectionState
-    mTextures.load(Textures::mapSelectionBackground, "Media/UI/MapSelectionStateBackground.png");
-    mTextures.load(Textures::homeButton, "Media/UI/buttons/homeButton.png");
-    mTextures.load(Textures::miniMap1, "Media/UI/miniMapUnlocked/miniMap1.png");
-    mTextures.load(Textures::miniMap2, "Media/UI/miniMapUnlocked/miniMap2.png");
-    mTextures.load(Textures::miniMap3, "Media/UI/miniMapUnlocked/miniMap3.png");
-    mTextures.load(Textures::miniMap4, "Media/UI/miniMapUnlocked/miniMap4.png");
-    mTextures.load(Textures::miniMap2Locked, "Media/UI/miniMapLocked/miniMap2Locked.png");
-    mTextures.load(Textures::miniMap3Locked, "Media/UI/miniMapLocked/miniMap3Locked.png");
-    mTextures.load(Textures::miniMap4Locked, "Media/UI/miniMapLocked/miniMap4Locked.png");
-    mTextures.load(Textures::wave, "Media/UI/icons/wave.png");
+    mTextures.pack(mLoader, Textures::constructionicon, "Media/Textures/ConstructionIcon.png");
 
     // Load UI in PauseState 
-    mTextures.load(Textures::pauseButton, "Media/UI/buttons/pauseButton.png");
-    mTextures.load(Textures::pausePanel, "Media/UI/pausePanel.png");
-    mTextures.load(Textures::restartButton, "Media/UI/buttons/restartButton.png");
-    mTextures.load(Textures::quitButton, "Media/UI/buttons/quitButton.png");
+    mTextures.pack(mLoader, Textures::pauseButton, "Media/UI/buttons/pauseButton.png");
+    mTextures.load(mLoader, Textures::pausePanel, "Media/UI/pausePanel.png");
+    mTextures.load(mLoader, Textures::restartButton, "Media/UI/buttons/restartButton.png");
+    mTextures.load(mLoader, Textures::quitButton, "Media/UI/buttons/quitButton.png");
 
     // Load UI in GameState
-    mTextures.load(Textures::commingWave, "Media/UI/icons/commingWave.png");
-    mTextures.load(Textures::heartIcon, "Media/UI/icons/heartIcon.png");
-    mTextures.load(Textures::waveIcon, "Media/UI/icons/waveIcon.png");
-    mTextures.load(Textures::currencyIcon, "Media/UI/icons/currencyIcon.png");
+    mTextures.pack(mLoader, Textures::commingWave, "Media/UI/icons/commingWave.png");
+    mTextures.pack(mLoader, Textures::heartIcon, "Media/UI/icons/heartIcon.png");
+    mTextures.pack(mLoader, Textures::waveIcon, "Media/UI/icons/waveIcon.png");
+    mTextures.pack(mLoader, Textures::currencyIcon, "Media/UI/icons/currencyIcon.png");
 
     // Load UI in VictoryState
-    mTextures.load(Textures::victory, "Media/UI/icons/victory.png");
-    mTextures.load(Textures::star, "Media/UI/icons/star.png");
+    mTextures.load(mLoader, Textures::victory, "Media/UI/icons/victory.png");
 
     // Load UI in DefeatState
-    mTextures.load(Textures::defeat, "Media/UI/icons/defeat.png");
-    mTextures.load(Textures::restartButton2, "Media/UI/buttons/restartButton2.png");
-    mTextures.load(Textures::quitButton2, "Media/UI/buttons/quitButton2.png");
-
-    mTextures.load(Textures::powerStation, "Media/Textures/power_station_sprite_sheet.png");
-    mTextures.load(Textures::tower1Button, "Media/UI/buttons/tower1Button.png");
-    mTextures.load(Textures::tower2Button, "Media/UI/buttons/tower2Button.png");
-    mTextures.load(Textures::tower3Button, "Media/UI/buttons/tower3Button.png");
-    mTextures.load(Textures::circle, "Media/UI/icons/circle.png");
-
-    // Load Texture in InputNameState 
-    mTextures.load(Textures::inputNameBackground, "Media/Textures/inputNameBackground.png");
-    mTextures.load(Textures::nextButton, "Media/UI/buttons/nextButton.png");
+    mTextures.load(mLoader, Textures::defeat, "Media/UI/icons/defeat.png");
+    mTextures.load(mLoader, Textures::restartButton2, "Media/UI/buttons/restartButton2.png");
+    mTextures.load(mLoader, Textures::quitButton2, "Media/UI/buttons/quitButton2.png");
 
-    // Load UI in SaveMangement for Loading
-    mTextures.load(Textures::loadBackground, "Media/UI/loadBackground.png");
-    mTextures.load(Textures::nameBar, "Media/UI/buttons/nameBar.png");
+    mTextures.pack(mLoader, Textures::powerStation, "Media/Textures/power_station_sprite_sheet.png", sf::Vector2u(0, 92));
+    mTextures.pack(mLoader, Textures::tower1Button, "Media/UI/buttons/tower1Button.png");
+    mTextures.pack(mLoader, Textures::tower2Button, "Media/UI/buttons/tower2Button.png");
+    mTextures.pack(mLoader, Textures::tower3Button, "Media/UI/buttons/tower3Button.png");
+    mTextures.pack(mLoader, Textures::circle, "Media/UI/icons/circle.png");
 
     // Load sound and music
-    mSoundBuffers.load(SoundBuffers::BulletBomb, "Audio/BulletBomb.wav");
-    mSoundBuffers.load(SoundBuffers::BulletFire, "Audio/BulletFire.wav");
-    mSoundBuffers.load(SoundBuffers::BulletLaser, "Audio/BulletLaser.wav");
-
-    mSoundBuffers.load(SoundBuffers::EnemyAttack, "Audio/EnemyAttack.wav");
-    mSoundBuffers.load(SoundBuffers::EnemyDead, "Audio/EnemyDead.wav");
-    mSoundBuffers.load(SoundBuffers::EnemyWalk, "Audio/EnemyWalk.wav");
+    mSoundBuffers.load(mLoader, SoundBuffers::BulletBomb, "Audio/BulletBomb.wav");
+    mSoundBuffers.load(mLoader, SoundBuffers::BulletFire, "Audio/BulletFire.wav");
+    mSoundBuffers.load(mLoader, SoundBuffers::BulletLaser, "Audio/BulletLaser.wav");
 
-    mSoundBuffers.load(SoundBuffers::GameOver, "Audio/GameOver.wav");
-    mSoundBuffers.load(SoundBuffers::GameWin, "Audio/GameWin.wav");
+    mSoundBuffers.load(mLoader, SoundBuffers::EnemyAttack, "Audio/EnemyAttack.wav");
+    mSoundBuffers.load(mLoader, SoundBuffers::EnemyDead, "Audio/EnemyDead.wav");
+    mSoundBuffers.load(mLoader, SoundBuffers::EnemyWalk, "Audio/EnemyWalk.wav");
 
-    mSoundBuffers.load(SoundBuffers::TowerPlace, "Audio/TowerPlace.wav");
-    mSoundBuffers.load(SoundBuffers::TowerUpgrade, "Audio/TowerUpgrade.wav");
+    mSoundBuffers.load(mLoader, SoundBuffers::GameOver, "Audio/GameOver.wav");
+    mSoundBuffers.load(mLoader, SoundBuffers::GameWin, "Audio/GameWin.wav");
 
-    mSoundBuffers.load(SoundBuffers::UIclick, "Audio/UIclick.wav");
-    mMusics.open(Musics::MusicGame, "Audio/MusicGame.wav");
-    mMusics.open(Musics::MusicMenu, "Audio/MusicMenu.wav");
+    mSoundBuffers.load(mLoader, SoundBuffers::TowerPlace, "Audio/TowerPlace.wav");
+    mSoundBuffers.load(mLoader, SoundBuffers::TowerUpgrade, "Audio/TowerUpgrade.wav");
 
     // Load collision effect
-    mTextures.load(Textures::BombImpact, "Media/Textures/BombImpact.png");
-    mTextures.load(Textures::FireImpact, "Media/Textures/FireImpact.png");
-    mTextures.load(Textures::IceImpact, "Media/Textures/IceImpact.png");
+    mTextures.pack(mLoader, Textures::BombImpact, "Media/Textures/BombImpact.png");
+    mTextures.pack(mLoader, Textures::FireImpact, "Media/Textures/FireImpact.png");
+    mTextures.pack(mLoader, Textures::IceImpact, "Media/Textures/IceImpact.png");
+
+    // Sheets drawn every frame in game share atlas pages, so they batch together
+    mLoader.enqueue([] {}, [this] {
+        mTextures.buildAtlas();
+        mFonts.prewarm(Fonts::BruceForever, 30);              // Game HUD counters
+        mFonts.prewarm(Fonts::BruceForever, 36, true, 2.f);   // "Not enough money" toast
+    });
+    mLoader.endTier(Assets::Game);
 }
 
 void Application::run()
@@ -187,6 +227,7 @@ void Application::run()
 
 void Application::registerStates()
 {
+    mStateStack.registerState<LoadingState>(States::Loading);
     mStateStack.registerState<MenuState>(States::Menu);
     mStateStack.registerState<GameState>(States::Game);
     mStateStack.registerState<PauseState>(States::Pause);
@@ -206,7 +247,7 @@ void Application::processInput()
     {
         // Global click sound logic
         if (event.type == sf::Event::MouseButtonPressed) {
-            if (isSoundOn) {
+            if (isSoundOn && mLoader.isReady(Assets::Menu)) {
                 mClickSound.setBuffer(mSoundBuffers.get(SoundBuffers::UIclick));
                 mClickSound.play();
             }
@@ -221,6 +262,8 @@ void Application::processInput()
 
 void Application::update(sf::Time dt)
 {
+    // Upload what the workers have decoded, but never enough to drop a frame
+    mLoader.update(sf::milliseconds(4));
     mStateStack.update(dt);
 
     if (mStateStack.isEmpty())
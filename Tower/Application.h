@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ResourceHolder.h"
+#include "ResourceLoader.h"
 #include "ResourceIdentifiers.h"
 #include "Player.h"
 #include "StateStack.h"
@@ -26,6 +27,9 @@ private:
     // Registers all possible game states into the state stack
     void registerStates();
 
+    // Queues every image and sound on mLoader, tier by tier
+    void queueAssets();
+
     sf::RenderWindow mWindow;
     TextureHolder mTextures;
     FontHolder mFonts;
@@ -36,11 +40,13 @@ private:
     MusicState currentMusic = MusicState::None;
     SoundBufferHolder mSoundBuffers;
     MusicHolder mMusics;
+    ResourceLoader mLoader; // Declared after the holders, so its workers stop before they go
 
     float gameSpeed = 1.0f;
 
     bool isMusicOn = true;
     bool isSoundOn = true;
+    bool restartLevel = false;
 
 private:
     sf::Sound mClickSound;
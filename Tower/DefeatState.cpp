@@ -71,8 +71,8 @@ bool DefeatState::handleEvent(const sf::Event& event) {
 
 		// Restart button
 		if (restartButton.getGlobalBounds().contains(mousePos)) {
-			requestStateClear(); // Clear all states including VictoryState & GameState
-			requestStackPush(States::Game); // Push fresh GameState
+			*getContext().restartLevel = true;
+			requestStackPop(); // Back to GameState, which resets the level in place
 			return true;
 		}
 
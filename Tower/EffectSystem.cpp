@@ -0,0 +1,104 @@
+#include "EffectSystem.h"
+#include "RenderQueue.h"
+#include <algorithm>
+
+EffectSystem::EffectSystem()
+    : mLive(0)
+{
+}
+
+int EffectSystem::addEffect(const Effect& effect)
+{
+    Kind kind;
+    sf::Vector2i frame = effect.sheet.toTexels(effect.frameWidth, effect.frameHeight);
+    kind.firstFrame = sf::IntRect(effect.sheet.rect.left, effect.sheet.rect.top, frame.x, frame.y);
+
+    sf::Vector2f scale = effect.sheet.spriteScale(effect.scale, effect.scale);
+    kind.size = sf::Vector2f(frame.x * scale.x, frame.y * scale.y);
+    kind.offset = sf::Vector2f(-kind.size.x * effect.origin.x, -kind.size.y * effect.origin.y);
+    kind.frameCount = effect.frameCount;
+    kind.frameTime = effect.frameTime;
+    kind.texture = effect.sheet.texture;
+    kind.layer = effect.layer;
+
+    mKinds.push_back(kind);
+    return (int)mKinds.size() - 1;
+}
+
+void EffectSystem::spawn(int effect, sf::Vector2f position)
+{
+    // Reuse a finished slot when there is one, the arrays only ever grow
+    if (mLive == mX.size())
+    {
+        mX.push_back(0.f);
+        mY.push_back(0.f);
+        mAge.push_back(0.f);
+        mKind.push_back(0);
+    }
+
+    mX[mLive] = position.x;
+    mY[mLive] = position.y;
+    mAge[mLive] = 0.f;
+    mKind[mLive] = effect;
+    ++mLive;
+}
+
+void EffectSystem::clear()
+{
+    mLive = 0;
+}
+
+void EffectSystem::update(float dt)
+{
+    std::size_t i = 0;
+    while (i < mLive)
+    {
+        mAge[i] += dt;
+
+        const Kind& kind = mKinds[mKind[i]];
+        if (mAge[i] < kind.frameCount * kind.frameTime)
+        {
+            ++i;
+            continue;
+        }
+
+        // Finished, move the last live particle into this slot
+        --mLive;
+        mX[i] = mX[mLive];
+        mY[i] = mY[mLive];
+        mAge[i] = mAge[mLive];
+        mKind[i] = mKind[mLive];
+    }
+}
+
+void EffectSystem::writeQuad(std::size_t particle, sf::Vertex* quad) const
+{
+    const Kind& kind = mKinds[mKind[particle]];
+    int frame = std::min((int)(mAge[particle] / kind.frameTime), kind.frameCount - 1);
+
+    float left = mX[particle] + kind.offset.x, right = left + kind.size.x;
+    float top = mY[particle] + kind.offset.y, bottom = top + kind.size.y;
+    float u0 = (float)(kind.firstFrame.left + frame * kind.firstFrame.width), u1 = u0 + kind.firstFrame.width;
+    float v0 = (float)kind.firstFrame.top, v1 = v0 + kind.firstFrame.height;
+
+    quad[0] = sf::Vertex(sf::Vector2f(left, top), sf::Vector2f(u0, v0));
+    quad[1] = sf::Vertex(sf::Vector2f(left, bottom), sf::Vector2f(u0, v1));
+    quad[2] = sf::Vertex(sf::Vector2f(right, top), sf::Vector2f(u1, v0));
+    quad[3] = quad[2];
+    quad[4] = quad[1];
+    quad[5] = sf::Vertex(sf::Vector2f(right, bottom), sf::Vector2f(u1, v1));
+}
+
+void EffectSystem::queue(RenderQueue& queue, const ViewCuller& culler) const
+{
+    sf::Vertex quad[6];
+    for (std::size_t i = 0; i < mLive; ++i)
+    {
+        const Kind& kind = mKinds[mKind[i]];
+        if (!culler.isVisible(sf::FloatRect(sf::Vector2f(mX[i], mY[i]) + kind.offset, kind.size)))
+            continue;
+
+        writeQuad(i, quad);
+        queue.add(quad, kind.texture, kind.layer, mY[i]);
+    }
+}
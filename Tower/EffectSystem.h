@@ -0,0 +1,62 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "TextureAtlas.h"
+#include "ViewCuller.h"
+
+class RenderQueue;
+
+// Fire-and-forget sprite sheet effects such as muzzle flashes and impacts.
+// Effect kinds are registered once; spawn() takes a particle from a pool
+// whose fields live in parallel arrays, so nothing that triggered it has to
+// stay alive while it plays. Finished particles are swapped out of the live
+// range and their slots reused. Live particles are queued as quads on the
+// frame's RenderQueue, so they sort by layer and depth with the sprites.
+class EffectSystem
+{
+public:
+    struct Effect
+    {
+        TextureRegion sheet; // Frames laid out left to right from the region's corner
+        int frameWidth, frameHeight; // Authored pixels
+        int frameCount;
+        float frameTime;
+        float scale;
+        sf::Vector2f origin; // Spawn point inside the frame, as a fraction of its size
+        std::uint8_t layer;  // RenderQueue layer, depth is the spawn point's y
+    };
+
+    EffectSystem();
+
+    int addEffect(const Effect& effect); // Returns the kind index for spawn
+    void spawn(int effect, sf::Vector2f position);
+    void clear(); // Drops live particles, kinds stay registered
+
+    void update(float dt);
+    void queue(RenderQueue& queue, const ViewCuller& culler) const; // Visible particles only
+
+    std::size_t getLiveCount() const { return mLive; }
+
+private:
+    struct Kind
+    {
+        sf::IntRect firstFrame; // Texels of frame 0
+        sf::Vector2f size;      // On screen
+        sf::Vector2f offset;    // Top-left corner relative to the spawn point
+        int frameCount;
+        float frameTime;
+        const sf::Texture* texture;
+        std::uint8_t layer;
+    };
+
+    void writeQuad(std::size_t particle, sf::Vertex* quad) const;
+
+    std::vector<Kind> mKinds;
+
+    // Particle pool, one entry per slot in each array; [0, mLive) are playing
+    std::vector<float> mX, mY;
+    std::vector<float> mAge;
+    std::vector<int> mKind;
+    std::size_t mLive;
+};
@@ -6,7 +6,8 @@ FrameAnimator::FrameAnimator()
     _loop(true), _finished(false) {
 }
 
-void FrameAnimator::init(int frameWidth, int frameHeight, float frameSpeed, int totalFrames, bool loop) {
+void FrameAnimator::init(int frameWidth, int frameHeight, float frameSpeed, int totalFrames, bool loop,
+    sf::Vector2i sheetOrigin) {
     _frameWidth = frameWidth;
     _frameHeight = frameHeight;
     _frameSpeed = frameSpeed;
@@ -15,7 +16,8 @@ void FrameAnimator::init(int frameWidth, int frameHeight, float frameSpeed, int
     _currentFrame = 0;
     _timer = 0.f;
     _finished = false;
-    _frameRect = sf::IntRect(0, 0, _frameWidth, _frameHeight);
+    _sheetOrigin = sheetOrigin;
+    _frameRect = sf::IntRect(_sheetOrigin.x, _sheetOrigin.y, _frameWidth, _frameHeight);
 }
 
 void FrameAnimator::update(float deltaTime) {
@@ -34,7 +36,7 @@ void FrameAnimator::update(float deltaTime) {
             }
         }
 
-        _frameRect.left = _currentFrame * _frameWidth;
+        _frameRect.left = _sheetOrigin.x + _currentFrame * _frameWidth;
     }
 }
 
@@ -46,7 +48,7 @@ void FrameAnimator::reset() {
     _currentFrame = 0;
     _timer = 0.f;
     _finished = false;
-    _frameRect.left = 0;
+    _frameRect.left = _sheetOrigin.x;
 }
 
 bool FrameAnimator::isFinished() const {
@@ -5,7 +5,9 @@ class FrameAnimator {
 public:
     FrameAnimator();
 
-    void init(int frameWidth, int frameHeight, float frameSpeed, int totalFrames, bool loop = true);
+    // sheetOrigin is where frame 0 sits in the texture, non-zero for atlas regions
+    void init(int frameWidth, int frameHeight, float frameSpeed, int totalFrames, bool loop = true,
+        sf::Vector2i sheetOrigin = sf::Vector2i());
     void update(float deltaTime);
     void applyTo(sf::Sprite& sprite);
 
@@ -15,6 +17,7 @@ public:
     // Getter
     int getFrameWidth() const { return _frameWidth; }
     int getFrameHeight() const { return _frameHeight; }
+    const sf::IntRect& getFrameRect() const { return _frameRect; }
 
 private:
     int _frameWidth;
@@ -25,6 +28,7 @@ private:
     float _timer;
     bool _loop;
     bool _finished;
+    sf::Vector2i _sheetOrigin;
     sf::IntRect _frameRect;
 };
 
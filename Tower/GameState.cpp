@@ -1,15 +1,17 @@
 #include "GameState.h"
 #include "MapSelectionState.h"
+#include "ResourceLoader.h"
 #include "Utility.h"
 #include <iostream>
 #include <sstream>
+#include <algorithm>
 
 GameState::GameState(StateStack& stack, Context context)
     : State(stack, context),
+    font(context.fonts->get(Fonts::BruceForever)),
     TOWER_RANGE(300.f),
     currentLevelIndex(MapSelectionState::levelID),
     waveIndex(0),
-    levels(),
     isGameOver(false),
     isGameWin(false),
     hasPressedPlay(false),
@@ -18,6 +20,9 @@ GameState::GameState(StateStack& stack, Context context)
     showTowerRange(false),
     isChoosingTower(false)
 {
+    // Blocks only if the player got here before the game sheets finished streaming
+    getContext().loader->require(Assets::Game);
+
     // Load music
     auto& musicFlag = *getContext().isMusicOn;
     auto& musicState = *getContext().currentMusic;
@@ -36,20 +41,15 @@ GameState::GameState(StateStack& stack, Context context)
     }
 
     // Load textures
-    backgroundTexture[0] = &getContext().textures->get(Textures::Map1);
-    backgroundTexture[1] = &getContext().textures->get(Textures::Map2);
-    backgroundTexture[2] = &getContext().textures->get(Textures::Map3);
-    backgroundTexture[3] = &getContext().textures->get(Textures::Map4);
-
     mainTowerTexture = &getContext().textures->get(Textures::MainTower);
 
     // Load Tower textures
-    towerTexture[0] = &getContext().textures->get(Textures::Tower1);
-    towerTexture[1] = &getContext().textures->get(Textures::Tower2);
-    towerTexture[2] = &getContext().textures->get(Textures::Tower3);
-    towerTexture[3] = &getContext().textures->get(Textures::Tower1plus);
-    towerTexture[4] = &getContext().textures->get(Textures::Tower2plus);
-    towerTexture[5] = &getContext().textures->get(Textures::Tower3plus);
+    towerSheet[0] = getContext().textures->getRegion(Textures::Tower1);
+    towerSheet[1] = getContext().textures->getRegion(Textures::Tower2);
+    towerSheet[2] = getContext().textures->getRegion(Textures::Tower3);
+    towerSheet[3] = getContext().textures->getRegion(Textures::Tower1plus);
+    towerSheet[4] = getContext().textures->getRegion(Textures::Tower2plus);
+    towerSheet[5] = getContext().textures->getRegion(Textures::Tower3plus);
 
     // Load Tower Infos
     infoTexture[0] = &getContext().textures->get(Textures::Info1);
@@ -60,19 +60,26 @@ GameState::GameState(StateStack& stack, Context context)
     infoTexture[5] = &getContext().textures->get(Textures::Info3plus);
 
     // Load buttons's texture for choosing tower
-    towerChoosingButtons[0].setTexture(context.textures->get(Textures::tower1Button));
-    towerChoosingButtons[1].setTexture(context.textures->get(Textures::tower2Button));
-    towerChoosingButtons[2].setTexture(context.textures->get(Textures::tower3Button));
-    towerChoosingCircle.setTexture(context.textures->get(Textures::circle));
+    context.textures->getRegion(Textures::tower1Button).applyTo(towerChoosingButtons[0]);
+    context.textures->getRegion(Textures::tower2Button).applyTo(towerChoosingButtons[1]);
+    context.textures->getRegion(Textures::tower3Button).applyTo(towerChoosingButtons[2]);
+    context.textures->getRegion(Textures::circle).applyTo(towerChoosingCircle);
 
     // Load Bullet textures
-    bulletTexture[0] = &getContext().textures->get(Textures::Bomb);
-    bulletTexture[1] = &getContext().textures->get(Textures::Fire);
-    bulletTexture[2] = &getContext().textures->get(Textures::Ice);
-    bulletTexture[3] = &getContext().textures->get(Textures::Bomb);
-    bulletTexture[4] = &getContext().textures->get(Textures::Fire);
-    bulletTexture[5] = &getContext().textures->get(Textures::Ice);
-    font = getContext().fonts->get(Fonts::BruceForever);
+    bulletSheet[0] = getContext().textures->getRegion(Textures::Bomb);
+    bulletSheet[1] = getContext().textures->getRegion(Textures::Fire);
+    bulletSheet[2] = getContext().textures->getRegion(Textures::Ice);
+    bulletSheet[3] = getContext().textures->getRegion(Textures::Bomb);
+    bulletSheet[4] = getContext().textures->getRegion(Textures::Fire);
+    bulletSheet[5] = getContext().textures->getRegion(Textures::Ice);
+
+    // Register shot and impact effects, indexed by base tower type
+    const Textures::ID flashTextures[3] = { Textures::BombShootEffect, Textures::FireShootEffect, Textures::IceShootEffect };
+    for (int i = 0; i < 3; ++i)
+        shootEffect[i] = effects.addEffect({ getContext().textures->getRegion(flashTextures[i]), 30, 23, 5, 0.05f, 3.f, Vector2f(1.f / 3.f, 1.f), LayerEffects });
+    impactEffect[0] = effects.addEffect({ getContext().textures->getRegion(Textures::BombImpact), 542 / 9, 62, 9, 0.05f, 1.7f, Vector2f(0.5f, 0.5f), LayerProjectiles });
+    impactEffect[1] = effects.addEffect({ getContext().textures->getRegion(Textures::FireImpact), 283 / 5, 44, 5, 0.09f, 1.7f, Vector2f(0.5f, 0.5f), LayerProjectiles });
+    impactEffect[2] = effects.addEffect({ getContext().textures->getRegion(Textures::IceImpact), 388 / 6, 69, 6, 0.09f, 1.4f, Vector2f(0.5f, 0.5f), LayerProjectiles });
 
     // Load info tower texture
     for (int i = 0; i < 6; ++i)
@@ -85,33 +92,33 @@ GameState::GameState(StateStack& stack, Context context)
     sellButton.setTexture(context.textures->get(Textures::sellButton));
 
     // Load Construction Icon
-    for (int i = 0; i < 7; ++i) {
-        constructionicons[i].setTexture(context.textures->get(Textures::constructionicon));
+    for (int i = 0; i < LevelFile::MAX_SLOTS; ++i) {
+        context.textures->getRegion(Textures::constructionicon).applyTo(constructionicons[i]);
         // set bool
         towerconstructed[i] = false;
     }
 
     // Load UI texture 
-    pauseButton.setTexture(context.textures->get(Textures::pauseButton));
+    context.textures->getRegion(Textures::pauseButton).applyTo(pauseButton);
     pauseButton.setPosition(1880.f, 50.f);
     centerOrigin(pauseButton);
 
-    commingWave.setTexture(context.textures->get(Textures::commingWave));
+    context.textures->getRegion(Textures::commingWave).applyTo(commingWave);
     if (currentLevelIndex == 3)
         commingWave.setPosition(60.f, 700.f);
     else
         commingWave.setPosition(60.f, 780.f);
     centerOrigin(commingWave);
 
-    heartIcon.setTexture(context.textures->get(Textures::heartIcon));
+    context.textures->getRegion(Textures::heartIcon).applyTo(heartIcon);
     heartIcon.setPosition(140.f, 60.f);
     centerOrigin(heartIcon);
 
-    currencyIcon.setTexture(context.textures->get(Textures::currencyIcon));
+    context.textures->getRegion(Textures::currencyIcon).applyTo(currencyIcon);
     currencyIcon.setPosition(380.f, 60.f);
     centerOrigin(currencyIcon);
 
-    waveIcon.setTexture(context.textures->get(Textures::waveIcon));
+    context.textures->getRegion(Textures::waveIcon).applyTo(waveIcon);
     waveIcon.setPosition(140.f, 130.f);
     centerOrigin(waveIcon);
 
@@ -128,33 +135,11 @@ GameState::GameState(StateStack& stack, Context context)
     notEnoughText.setStyle(Text::Bold);
     notEnoughText.setPosition(1920.f * 0.5f - 180.f, 1080.f * 0.5f - 20.f);
 
-    // Initialize 4 levels (levelID, enemyCount, waveCount, towerMaxCount, startGold) 
-    clevel level1(1, 45, 3, 5, 200);
-    level1.setWaves({ {FAST_SCOUT, 20}, {HEAVY_WALKER, 15}, {RANGED_MECH, 20} }); // 10, 15, 20
-    level1.loadMap(mainTowerTexture, backgroundTexture[0], 1);
-
-    clevel level2(2, 65, 3, 6, 400);
-    level2.setWaves({ {FAST_SCOUT, 15}, {HEAVY_WALKER, 20}, {RANGED_MECH, 30} }); // 15, 20, 30
-    level2.loadMap(mainTowerTexture, backgroundTexture[1], 2);
-
-    clevel level3(3, 100, 4, 6, 700);
-    level3.setWaves({ {FAST_SCOUT, 20}, {HEAVY_WALKER, 25}, {RANGED_MECH, 30}, {HEAVY_WALKER, 25} }); // 20, 25, 30, 25
-    level3.loadMap(mainTowerTexture, backgroundTexture[2], 3);
-
-    clevel level4(4, 175, 5, 7, 1000);
-    level4.setWaves({ {FAST_SCOUT, 25}, {HEAVY_WALKER, 30}, {RANGED_MECH, 35}, {FAST_SCOUT, 40}, {HEAVY_WALKER, 45} }); // 25, 30, 35, 40, 45
-    level4.loadMap(mainTowerTexture, backgroundTexture[3], 4);
-
-    levels.push_back(level1);
-    levels.push_back(level2);
-    levels.push_back(level3);
-    levels.push_back(level4);
-
     // Setup enemy data
     enemyData[RANGED_MECH] = {
-        &getContext().textures->get(Textures::Enemy1_Walk),
-        &getContext().textures->get(Textures::Enemy1_Attack),
-        &getContext().textures->get(Textures::Enemy1_Death),
+        getContext().textures->getRegion(Textures::Enemy1_Walk),
+        getContext().textures->getRegion(Textures::Enemy1_Attack),
+        getContext().textures->getRegion(Textures::Enemy1_Death),
         6, 6, 6, // frames walk, attack, death
         0.1f, 0.1f, 0.1f, // animation speeds
         126, 123, // frame width, frame height of walk sprite sheet
@@ -164,27 +149,27 @@ GameState::GameState(StateStack& stack, Context context)
     };
 
     enemyData[FAST_SCOUT] = {
-        &getContext().textures->get(Textures::Enemy2_Fly),
-        &getContext().textures->get(Textures::Enemy2_Attack),
-        &getContext().textures->get(Textures::Enemy2_Death),
+        getContext().textures->getRegion(Textures::Enemy2_Fly),
+        getContext().textures->getRegion(Textures::Enemy2_Attack),
+        getContext().textures->getRegion(Textures::Enemy2_Death),
         4, 6, 6,
         0.1f, 0.1f, 0.1f,
         209, 203,
         209, 203,
         209, 203,
-        0.5f, 0.5f,
+        GameConstants::SMALL_ENEMY_SCALE, GameConstants::SMALL_ENEMY_SCALE,
     };
 
     enemyData[HEAVY_WALKER] = {
-        &getContext().textures->get(Textures::Enemy3_Walk),
-        &getContext().textures->get(Textures::Enemy3_Attack),
-        &getContext().textures->get(Textures::Enemy3_Death),
+        getContext().textures->getRegion(Textures::Enemy3_Walk),
+        getContext().textures->getRegion(Textures::Enemy3_Attack),
+        getContext().textures->getRegion(Textures::Enemy3_Death),
         6, 6, 6,
         0.1f, 0.1f, 0.1f,
         213, 211,
         212, 210,
         212, 210,
-        0.5f, 0.5f,
+        GameConstants::SMALL_ENEMY_SCALE, GameConstants::SMALL_ENEMY_SCALE,
     };
 
     // Load Sound 
@@ -205,37 +190,40 @@ GameState::GameState(StateStack& stack, Context context)
     loadLevel(currentLevelIndex);
 }
 
-void GameState::draw()
+void GameState::spawnShootEffect(ctower& tower)
 {
-    RenderWindow& window = *getContext().window;
-    window.setView(window.getDefaultView());
-    Vector2f mousePos = window.mapPixelToCoords(Mouse::getPosition(window));
-    window.clear(Color::Black);
+    effects.spawn(shootEffect[tower.getType() % 3], tower.getSprite().getPosition() - Vector2f(0.f, 40.f));
+    tower.setFlashed();
+}
 
-    window.draw(backgroundSprite);
+void GameState::drawStaticLayer()
+{
+    RenderTarget& target = staticLayer.begin();
+
+    target.draw(backgroundSprite);
 
     // Draw Construction Icons
-    int numbericons;
+    for (int i = 0; i < curMap->getSlotCount(); ++i)
+        if (towerconstructed[i] == false)
+            target.draw(constructionicons[i]);
 
-    if (currentLevelIndex == 0) numbericons = 5;
-    else if (currentLevelIndex == 3) numbericons = 7;
-    else numbericons = 6;
+    target.draw(curMap->getMainTower().getSprite());
 
-    for (int i = 0; i < numbericons; ++i)
-        if (towerconstructed[i] == false)
-            window.draw(constructionicons[i]);
+    staticLayer.end();
+}
 
-    curMap->drawPowerStations(window);
-    window.draw(curMap->getMainTower().getSprite());
-    curMap->getMainTower().drawHealthBar(window);
+void GameState::draw()
+{
+    RenderWindow& window = *getContext().window;
+    window.setView(window.getDefaultView());
+    Vector2f mousePos = window.mapPixelToCoords(Mouse::getPosition(window));
+    window.clear(Color::Black);
 
-    window.draw(heartIcon);
-    window.draw(currencyIcon);
-    window.draw(waveIcon);
+    if (staticLayer.isDirty())
+        drawStaticLayer();
+    staticLayer.draw(window);
 
-    window.draw(hp);
-    window.draw(gold);
-    window.draw(wave);
+    curMap->drawProps(window);
 
     if (!hasPressedPlay && !isGameOver && !isGameWin) {
         if (commingWave.getGlobalBounds().contains(mousePos))
@@ -254,50 +242,39 @@ void GameState::draw()
     if (showTowerRange)
         window.draw(circleRange);
 
-    for (const auto& e : enemies) {
-        if (!e.hasReachedEnd() || e.getState() == DEATH) {
+    // Towers, enemies, projectiles and effects go through one sorted queue
+    renderQueue.clear();
+    for (const auto& e : enemies)
+        if ((!e.hasReachedEnd() || e.getState() == DEATH) && !e.isCulled())
+            renderQueue.add(e.getSprite(), LayerUnits, e.getSprite().getPosition().y);
+
+    for (const auto& tower : towers)
+        renderQueue.add(tower.getSprite(), LayerUnits, tower.getSprite().getPosition().y);
 
-            // Draw enemy
-            window.draw(e.getSprite());
+    for (const auto& b : bullets)
+        if (b.isActive() && culler.isVisible(b.getSprite().getGlobalBounds()))
+            renderQueue.add(b.getSprite(), LayerProjectiles, b.getSprite().getPosition().y);
 
-            // Draw enemy's hp bar
+    effects.queue(renderQueue, culler);
+    renderQueue.draw(window);
+
+    // Draw main tower and enemy hp bars in one call, above the world
+    healthBars.begin();
+    curMap->getMainTower().addHealthBar(healthBars);
+    for (const auto& e : enemies) {
+        if ((!e.hasReachedEnd() || e.getState() == DEATH) && !e.isCulled()) {
             float spriteHeight = e.getSprite().getGlobalBounds().height;
             float barWidth = 50.f;
             float barHeight = 6.f;
             float barX = e.getX() - barWidth + 15.f;
             float barY = e.getY() - spriteHeight / 2.f - 45.f;
 
-            // Black outline
-            RectangleShape hpOutline(Vector2f(barWidth, barHeight));
-            hpOutline.setPosition(barX, barY);
-            hpOutline.setFillColor(Color::Black);
-            window.draw(hpOutline);
-
-            // Green hp bar, decrease gradually
-            float hpPercent = static_cast<float>(e.getHealth()) / cenemy::getHealthByType(e.getType());
-            hpPercent = max(0.f, min(1.f, hpPercent));
-
-            RectangleShape hpBar(Vector2f(barWidth * hpPercent, barHeight));
-            hpBar.setPosition(barX, barY);
-            hpBar.setFillColor(Color::Green);
-            window.draw(hpBar);
+            // Black outline, green hp decreasing gradually
+            float hpPercent = static_cast<float>(e.getHealth()) / e.getMaxHealth();
+            healthBars.add(FloatRect(barX, barY, barWidth, barHeight), hpPercent, Color::Black, Color::Green);
         }
     }
-
-    for (const auto& tower : towers)
-        window.draw(tower.getSprite());
-
-    for (const auto& tower : towers)
-        if (tower.isEffectPlaying())
-            window.draw(tower.getEffectSprite());
-
-    for (auto& b : bullets) {
-        if (b.isActive())
-            window.draw(b.getSprite());
-        else if (b.isCollisionPlaying())
-            window.draw(b.getCollisionSprite());
-    }
-
+    healthBars.draw(window);
 
     // Draw choosingTowerButton
     if (isChoosingTower) {
@@ -331,9 +308,8 @@ void GameState::draw()
         }
     }
 
-    // Draw text "Not enough money!" 
-    if (showNotEnough)
-        window.draw(notEnoughText);
+    // HUD on top of everything, cached until a value changes
+    hud.draw(window);
 }
 
 bool GameState::handleEvent(const Event& event)
@@ -393,35 +369,31 @@ bool GameState::handleEvent(const Event& event)
                     if (*getContext().isSoundOn == true)
                         towerPlaceSound.play();
 
-                    if (towers.size() < levels[currentLevelIndex].getTowerMaxCount()) {
+                    if (towers.size() < curLevel->getTowerMaxCount()) {
                         ctower t;
-                        td = MapHandle::getTowerdes(currentLevelIndex, selectedTile.getRow(), selectedTile.getCol());
-                        int itower = MapHandle::findBlockmap(currentLevelIndex, td.first, td.second);
-                        t.init(*towerTexture[towerType],
-                            curMap->getMap()[td.first][td.second].getPixelX(),
-                            curMap->getMap()[td.first][td.second].getPixelY(), currentLevelIndex, itower);
-                        t.setLocation(cpoint(td.first, td.second, 1));
-                        t.setMapForBullet(curMap->getMap());
+                        td = MapHandle::getTowerdes(*curMap, selectedTile.getRow(), selectedTile.getCol());
+                        int itower = MapHandle::findBlockmap(*curMap, td.first, td.second);
+                        cpoint towerTile(td.first, td.second);
+                        t.init(towerSheet[towerType],
+                            towerTile.getPixelX(),
+                            towerTile.getPixelY(), curMap->getSlot(itower));
+                        t.setLocation(towerTile);
+                        t.setMapForBullet(curMap->getTiles());
                         t.getBullet().setSpeed(8);
                         t.setType(towerType);
 
-                        switch (towerType) {
-                        case 0: t.initEffect(getContext().textures->get(Textures::BombShootEffect), 30, 23, 5, 0.05f); break;
-                        case 1: t.initEffect(getContext().textures->get(Textures::FireShootEffect), 30, 23, 5, 0.05f); break;
-                        case 2: t.initEffect(getContext().textures->get(Textures::IceShootEffect), 30, 23, 5, 0.05f); break;
-                        }
-
-                        int index = MapHandle::findBlockmap(currentLevelIndex, td.first, td.second);
-                        towerconstructed[index] = true;
+                        int index = MapHandle::findBlockmap(*curMap, td.first, td.second);
+                        setConstructed(index, true);
 
+                        t.computeCoverage(curMap->getPath(), TOWER_RANGE);
                         towers.push_back(t);
-                        MapHandle::setCmap(currentLevelIndex, *curMap, selectedTile.getRow(), selectedTile.getCol(), towerType + 3);
+                        MapHandle::setSlotTower(*curMap, selectedTile.getRow(), selectedTile.getCol(), towerType);
 
                         // Save when new tower placed
                         int tCurLevel = currentLevelIndex;
                         SaveManagement::playerResult[tCurLevel].status = -1; // not finished
                         SaveManagement::playerResult[tCurLevel].stars = 0;
-                        SaveManagement::playerResult[tCurLevel].curWave = levels[tCurLevel].getCurrentWaveIndex();
+                        SaveManagement::playerResult[tCurLevel].curWave = curLevel->getCurrentWaveIndex();
                         SaveManagement::playerResult[tCurLevel].curGold = (player.getMoney() == 0) ? -1 : player.getMoney();
                         SaveManagement::playerResult[tCurLevel].towers.clear();
                         for (int i = 0; i < towers.size(); i++)
@@ -464,28 +436,28 @@ bool GameState::handleEvent(const Event& event)
 
                     // Get the designated tile and upgrade C value
                     int row = -1, col = -1;
-                    td = MapHandle::getTowerdes(currentLevelIndex, selectedRow, selectedCol);
+                    td = MapHandle::getTowerdes(*curMap, selectedRow, selectedCol);
                     row = td.first;
                     col = td.second;
                     if (row != -1 && col != -1) {
-                        int newC = tileC + 3;
-                        // Update map C value for upgraded tower
-                        MapHandle::setCmap(currentLevelIndex, *curMap, row, col, newC);
+                        int newType = tileC;
+                        // Update map tiles for upgraded tower
+                        MapHandle::setSlotTower(*curMap, row, col, newType);
                         // Update the tower's type and texture
                         for (auto& t : towers) {
                             if (t.getLocation().getRow() == row && t.getLocation().getCol() == col) {
-                                t.setType(newC - 3);
-                                int itower = MapHandle::findBlockmap(currentLevelIndex, row, col);
-                                t.init(*towerTexture[newC - 3],
-                                    curMap->getMap()[row][col].getPixelX(),
-                                    curMap->getMap()[row][col].getPixelY(), currentLevelIndex, itower);
+                                t.setType(newType);
+                                int itower = MapHandle::findBlockmap(*curMap, row, col);
+                                t.init(towerSheet[newType],
+                                    cpoint(row, col).getPixelX(),
+                                    cpoint(row, col).getPixelY(), curMap->getSlot(itower));
 
                                 // Save when a tower upgraded
                                 int tCurLevel = currentLevelIndex;
                                 SaveManagement::playerResult[tCurLevel].status = -1; // not finished
                                 SaveManagement::playerResult[tCurLevel].stars = 0;
-                                SaveManagement::playerResult[tCurLevel].curWave = levels[tCurLevel].getCurrentWaveIndex();
-                                SaveManagement::playerResult[tCurLevel].curGold = (isGameOver || isGameWin) ? levels[currentLevelIndex].getStartGold() : player.getMoney();
+                                SaveManagement::playerResult[tCurLevel].curWave = curLevel->getCurrentWaveIndex();
+                                SaveManagement::playerResult[tCurLevel].curGold = (isGameOver || isGameWin) ? curLevel->getStartGold() : player.getMoney();
                                 SaveManagement::playerResult[tCurLevel].towers.clear();
 
                                 for (int i = 0; i < towers.size(); i++)
@@ -527,14 +499,14 @@ bool GameState::handleEvent(const Event& event)
             int tileC = selectedinfo;
             int row = -1, col = -1;
 
-            td = MapHandle::getTowerdes(currentLevelIndex, selectedRow, selectedCol);
+            td = MapHandle::getTowerdes(*curMap, selectedRow, selectedCol);
             row = td.first;
             col = td.second;
 
             if (row != -1 && col != -1) {
                 for (auto t = towers.begin(); t != towers.end(); ++t) {
-                    // Update map C value for upgraded tower
-                    MapHandle::setCmap(currentLevelIndex, *curMap, row, col, 2);
+                    // Free the slot tiles of the sold tower
+                    MapHandle::setSlotTower(*curMap, row, col, -1);
                     // Sell tower
                     if (t->getLocation().getRow() == row && t->getLocation().getCol() == col) {
                         towers.erase(t);
@@ -544,16 +516,16 @@ bool GameState::handleEvent(const Event& event)
                         else
                             player.addMoney((GameConstants::UPGRADE_COSTS[tileC - 6] + GameConstants::TOWER_COSTS[tileC - 6]) / 10 * 7);
 
-                        int index = MapHandle::findBlockmap(currentLevelIndex, row, col);
-                        towerconstructed[index] = false;
+                        int index = MapHandle::findBlockmap(*curMap, row, col);
+                        setConstructed(index, false);
 
                         // Save when a tower upgraded
                         int tCurLevel = currentLevelIndex;
                         SaveManagement::playerResult[tCurLevel].status = -1; // not finished
                         SaveManagement::playerResult[tCurLevel].stars = 0;
                         SaveManagement::playerResult[tCurLevel].health = (isGameWin || isGameOver) ? curMap->getMainTower().getMaxHealth() : curMap->getMainTower().getHealth();
-                        SaveManagement::playerResult[tCurLevel].curWave = levels[tCurLevel].getCurrentWaveIndex();
-                        SaveManagement::playerResult[tCurLevel].curGold = (isGameOver || isGameWin) ? levels[currentLevelIndex].getStartGold() : player.getMoney();
+                        SaveManagement::playerResult[tCurLevel].curWave = curLevel->getCurrentWaveIndex();
+                        SaveManagement::playerResult[tCurLevel].curGold = (isGameOver || isGameWin) ? curLevel->getStartGold() : player.getMoney();
                         SaveManagement::playerResult[tCurLevel].towers.clear();
 
                         for (int i = 0; i < towers.size(); i++)
@@ -581,15 +553,13 @@ bool GameState::handleEvent(const Event& event)
         if (clicked.getRow() >= 0 && clicked.getRow() < cpoint::MAP_ROW &&
             clicked.getCol() >= 0 && clicked.getCol() < cpoint::MAP_COL) {
 
-            int c = curMap->getMap()[clicked.getRow()][clicked.getCol()].getC();
-
-            // If clicked on a tile with C = 2 (candidate tower tile)
-            if (c == 2 && towers.size() < levels[currentLevelIndex].getTowerMaxCount()) {
+            // If clicked on a free tower slot tile
+            if (curMap->getTiles().isBuildable(clicked.getRow(), clicked.getCol()) && towers.size() < curLevel->getTowerMaxCount()) {
                 selectedTile = clicked;
                 isChoosingTower = true;
 
                 // Display tower options at click location
-                auto buttons = MapHandle::getTowerButtons(currentLevelIndex, selectedTile.getRow(), selectedTile.getCol());
+                auto buttons = MapHandle::getTowerButtons(*curMap, selectedTile.getRow(), selectedTile.getCol());
                 if (buttons.size() == 4) {
                     for (int i = 0; i < 3; ++i)
                         towerChoosingButtons[i].setPosition(buttons[i]);
@@ -608,23 +578,24 @@ bool GameState::handleEvent(const Event& event)
                 }
             }
 
-            // If clicked on a tile that already has a tower (C >= 3)
-            if (c >= 3 || clickedTower) {
-                selectedinfo = c;
-                if (clickedTower->getSprite().getTexture() == towerTexture[0]) selectedinfo = 3;
-                else if (clickedTower->getSprite().getTexture() == towerTexture[1]) selectedinfo = 4;
-                else if (clickedTower->getSprite().getTexture() == towerTexture[2]) selectedinfo = 5;
-                else if (clickedTower->getSprite().getTexture() == towerTexture[3]) selectedinfo = 6;
-                else if (clickedTower->getSprite().getTexture() == towerTexture[4]) selectedinfo = 7;
-                else if (clickedTower->getSprite().getTexture() == towerTexture[5]) selectedinfo = 8;
+            // If clicked on a tile that already has a tower
+            int clickedType = curMap->getTiles().getTowerType(clicked.getRow(), clicked.getCol());
+            if (clickedType != -1 || clickedTower) {
+                selectedinfo = clickedType + 3;
+                if (clickedTower->getSprite().getTexture() == towerSheet[0].texture) selectedinfo = 3;
+                else if (clickedTower->getSprite().getTexture() == towerSheet[1].texture) selectedinfo = 4;
+                else if (clickedTower->getSprite().getTexture() == towerSheet[2].texture) selectedinfo = 5;
+                else if (clickedTower->getSprite().getTexture() == towerSheet[3].texture) selectedinfo = 6;
+                else if (clickedTower->getSprite().getTexture() == towerSheet[4].texture) selectedinfo = 7;
+                else if (clickedTower->getSprite().getTexture() == towerSheet[5].texture) selectedinfo = 8;
                 selectedRow = clicked.getRow();
                 selectedCol = clicked.getCol();
                 // Get fixed display tile for showing info panel
-                pair<int, int> fixed = MapHandle::getTowerdes(currentLevelIndex, clicked.getRow(), clicked.getCol());
+                pair<int, int> fixed = MapHandle::getTowerdes(*curMap, clicked.getRow(), clicked.getCol());
                 if (fixed.first == -1 && fixed.second == -1) {
                     selectedRow = clicked.getRow() + 3;
                     selectedCol = clicked.getCol();
-                    fixed = MapHandle::getTowerdes(currentLevelIndex, selectedRow, selectedCol);
+                    fixed = MapHandle::getTowerdes(*curMap, selectedRow, selectedCol);
                 }
 
                 float fx = (float)fixed.second * cpoint::TILE_SIZE;
@@ -656,13 +627,24 @@ bool GameState::handleEvent(const Event& event)
 
 bool GameState::update(Time dt)
 {
-    // Set Icons
-    MapHandle::setIconsmap(currentLevelIndex, constructionicons);
+    // Restart asked for by an overlay state that has just popped
+    bool& restartLevel = *getContext().restartLevel;
+    if (restartLevel) {
+        restartLevel = false;
+        reset();
+        return true;
+    }
+
+    // Bring in the enemies of the running wave that are due
+    releaseEnemies(dt.asSeconds());
+
+    culler.setView(getContext().window->getDefaultView());
 
     //Enemy update - modify tower damage logic
     for (auto it = enemies.begin(); it != enemies.end(); ) {
         cenemy& e = *it;
         bool shouldErase = false;
+        e.setCulled(!culler.isVisible(Vector2f(e.getX(), e.getY()), e.getBoundingRadius()));
 
         cenemy& e0 = *enemies.begin();
         // Handle dead enemies first
@@ -690,60 +672,38 @@ bool GameState::update(Time dt)
 
         // Handle living enemies
         if (!e.hasReachedEnd()) {
-            if (e.getCurrentTarget() < e.getPathLength()) {
-                // Normal path following
-                float targetX = e.getP()[e.getCurrentTarget()].getPixelX();
-                float targetY = e.getP()[e.getCurrentTarget()].getPixelY();
-
-                float dx = targetX - e.getX();
-                float dy = targetY - e.getY();
-                float len = sqrt(dx * dx + dy * dy);
-
-                if (len < 1.f) {
-                    e.incrementTarget();
-
-                    // Check if reached final target
-                    if (e.getCurrentTarget() >= e.getPathLength()) {
-                        // If not already attacking, trigger attack
-                        if (e.getState() != ATTACK)
-                            e.triggerAttack();
-
-                        if (*getContext().isSoundOn) {
-                            bulletLaserSound.setVolume(20);
-                            bulletLaserSound.play();
-                        }
+            if (e.advance(dt.asSeconds())) {
+                // Reached the end of the path
+                // If not already attacking, trigger attack
+                if (e.getState() != ATTACK)
+                    e.triggerAttack();
 
-                        // Check if attack animation has finished
-                        if (e.hasFinishedAttackAnim()) {
-                            e.reachEnd();
-                            shouldErase = true;
-                        }
-
-                        curMap->getMainTower().takeDamage(e.getDamage());
+                if (*getContext().isSoundOn) {
+                    bulletLaserSound.setVolume(20);
+                    bulletLaserSound.play();
+                }
 
-                        if (curMap->getMainTower().isDestroyed()) {
-                            isGameOver = true;
-                            isGameWin = false;
-                        }
-                    }
+                // Check if attack animation has finished
+                if (e.hasFinishedAttackAnim()) {
+                    e.reachEnd();
+                    shouldErase = true;
                 }
-                else {
-                    // Normal movement
-                    dx /= len;
-                    dy /= len;
-
-                    // Rotate enemy sprite (only in level 3)
-                    if (currentLevelIndex == 2) {
-                        if (dx < -0.1f)
-                            e.faceLeft(e.getType());
-                        else if (dx > 0.1f || dy < -0.1f)
-                            e.faceRight(e.getType());
-                    }
 
-                    e.move(dx * e.getSpeedByType(e.getType()) * dt.asSeconds(),
-                        dy * e.getSpeedByType(e.getType()) * dt.asSeconds());
+                curMap->getMainTower().takeDamage(e.getDamage());
+
+                if (curMap->getMainTower().isDestroyed()) {
+                    isGameOver = true;
+                    isGameWin = false;
                 }
             }
+            else if (currentLevelIndex == 2) {
+                // Rotate enemy sprite (only in level 3)
+                sf::Vector2f heading = e.getHeading();
+                if (heading.x < -0.1f)
+                    e.faceLeft();
+                else if (heading.x > 0.1f || heading.y < -0.1f)
+                    e.faceRight();
+            }
 
             // Update animation for living enemies
             e.updateAnimation(dt.asSeconds());
@@ -769,8 +729,8 @@ bool GameState::update(Time dt)
 
 
     // The wave must be the last wave
-    if (!isGameOver && !isGameWin && curMap->getMainTower().getHealth() > 0 && enemies.empty() && hasPressedPlay) {
-        clevel& level = levels[currentLevelIndex];
+    if (!isGameOver && !isGameWin && curMap->getMainTower().getHealth() > 0 && enemies.empty() && spawner.isDone() && hasPressedPlay) {
+        clevel& level = *curLevel;
 
         if (!level.isLastWave()) {
             level.nextWave();
@@ -780,8 +740,8 @@ bool GameState::update(Time dt)
             SaveManagement::playerResult[tCurLevel].status = -1; // not finished
             SaveManagement::playerResult[tCurLevel].stars = 0;
             SaveManagement::playerResult[tCurLevel].health = (isGameWin || isGameOver) ? curMap->getMainTower().getMaxHealth() : curMap->getMainTower().getHealth();
-            SaveManagement::playerResult[tCurLevel].curWave = levels[tCurLevel].getCurrentWaveIndex();
-            SaveManagement::playerResult[tCurLevel].curGold = (isGameOver || isGameWin) ? levels[currentLevelIndex].getStartGold() : player.getMoney();
+            SaveManagement::playerResult[tCurLevel].curWave = curLevel->getCurrentWaveIndex();
+            SaveManagement::playerResult[tCurLevel].curGold = (isGameOver || isGameWin) ? curLevel->getStartGold() : player.getMoney();
             SaveManagement::playerResult[tCurLevel].towers.clear();
             for (int i = 0; i < towers.size(); i++)
             {
@@ -807,7 +767,7 @@ bool GameState::update(Time dt)
             SaveManagement::playerResult[tCurLevel].stars = 0;
             SaveManagement::playerResult[tCurLevel].health = curMap->getMainTower().getMaxHealth();
             SaveManagement::playerResult[tCurLevel].curWave = 0;
-            SaveManagement::playerResult[tCurLevel].curGold = levels[currentLevelIndex].getStartGold();
+            SaveManagement::playerResult[tCurLevel].curGold = curLevel->getStartGold();
             SaveManagement::playerResult[tCurLevel].towers.clear();
             SaveManagement::save(SaveManagement::playerName);
         }
@@ -826,7 +786,7 @@ bool GameState::update(Time dt)
         SaveManagement::playerResult[tCurLevel].stars = calStars();
         SaveManagement::playerResult[tCurLevel].health = curMap->getMainTower().getMaxHealth();
         SaveManagement::playerResult[tCurLevel].curWave = 0;
-        SaveManagement::playerResult[tCurLevel].curGold = levels[currentLevelIndex].getStartGold();
+        SaveManagement::playerResult[tCurLevel].curGold = curLevel->getStartGold();
         SaveManagement::playerResult[tCurLevel].towers.clear();
         SaveManagement::save(SaveManagement::playerName);
 
@@ -836,111 +796,78 @@ bool GameState::update(Time dt)
     }
 
     // Tower attack logic: target enemies and shoot
+    sortEnemiesByProgress();
     for (auto& tower : towers) {
         tower.addShootTimer(dt.asSeconds());
 
-        // Trigger shootEffect
-        if (tower.getTargetEnemyIdx() != -1 && tower.getShootTimer() > 0.8f && !tower.isEffectPlaying())
-            tower.startEffect();
+        // Trigger shootEffect, the flash leads the shot
+        if (tower.getTargetEnemyIdx() != -1 && tower.getShootTimer() > 0.8f && !tower.hasFlashed())
+            spawnShootEffect(tower);
 
         bool validTarget = false;
         int idx = tower.getTargetEnemyIdx();
 
         // Check current target still valid
-        if (idx >= 0 && idx < enemies.size() && !enemies[idx].hasReachedEnd() && !enemies[idx].isDead()) {
-            float dist = hypot(tower.getSprite().getPosition().x - enemies[idx].getX(),
-                tower.getSprite().getPosition().y - enemies[idx].getY());
-            if (dist <= TOWER_RANGE)
-                validTarget = true;
-        }
+        if (idx >= 0 && idx < enemies.size() && !enemies[idx].hasReachedEnd() && !enemies[idx].isDead())
+            validTarget = tower.covers(enemies[idx].getDistance());
 
         // Find new target if needed
-        if (!validTarget) {
-            tower.setTargetEnemyIdx(-1);
-            for (int i = 0; i < enemies.size(); i++) {
-                if (enemies[i].hasReachedEnd() || enemies[i].isDead()) continue;
-                float dist = hypot(tower.getSprite().getPosition().x - enemies[i].getX(),
-                    tower.getSprite().getPosition().y - enemies[i].getY());
-                if (dist <= TOWER_RANGE) {
-                    tower.setTargetEnemyIdx(i);
-                    break;
-                }
-            }
-        }
+        if (!validTarget)
+            tower.setTargetEnemyIdx(findTarget(tower));
 
         // Shoot bullet when cooldown is over
         if (tower.getTargetEnemyIdx() != -1 && tower.getShootTimer() > 1.f) {
-            tower.startEffect();
+            if (!tower.hasFlashed())
+                spawnShootEffect(tower);
             tower.resetShootTimer();
 
             cbullet b;
             cbullet b1;
             int t = tower.getType();
 
-            const Texture* tex = nullptr;
+            const TextureRegion* tex = nullptr;
             int frameW = 0, frameH = 0, totalFrames = 0;
             float animSpeed = 0.f, scale = 1.f;
 
             switch (t) {
             case 0: // Tower type 1 - Bomb
-                tex = bulletTexture[0];
+                tex = &bulletSheet[0];
                 frameW = 16; frameH = 15; totalFrames = 7;
                 animSpeed = 0.05f; scale = 4.f;
-
-                b.initCollisionEffect(getContext().textures->get(Textures::BombImpact), (float)542 / 9, 62, 9, 0.05f, 1.7f);
-
                 break;
 
             case 1: // Tower type 2 - Fire
-                tex = bulletTexture[1];
+                tex = &bulletSheet[1];
                 frameW = 1667; frameH = 1167; totalFrames = 4;
-                animSpeed = 0.05f; scale = 0.1f;
-
-                b.initCollisionEffect(getContext().textures->get(Textures::FireImpact), (float)283 / 5, 44, 5, 0.09f, 1.7f);
-
+                animSpeed = 0.05f; scale = GameConstants::FIRE_BULLET_SCALE;
                 break;
 
             case 2: // Tower type 3 - Ice
-                tex = bulletTexture[2];
+                tex = &bulletSheet[2];
                 frameW = 141; frameH = 114; totalFrames = 5;
                 animSpeed = 0.05f; scale = 0.8f;
-
-                b.initCollisionEffect(getContext().textures->get(Textures::IceImpact), (float)388 / 6, 69, 6, 0.09f, 1.4f);
-
                 break;
 
             case 3: // Tower type 1 - Upgraded - Bomb
-                tex = bulletTexture[0];
+                tex = &bulletSheet[0];
                 frameW = 16; frameH = 15; totalFrames = 7;
                 animSpeed = 0.05f; scale = 4.f;
-
-                b.initCollisionEffect(getContext().textures->get(Textures::BombImpact), (float)542 / 9, 62, 9, 0.05f, 1.7f);
-                b1.initCollisionEffect(getContext().textures->get(Textures::BombImpact), (float)542 / 9, 62, 9, 0.05f, 1.7f);
-
                 break;
 
             case 4: // Tower type 2 - Upgraded - Fire
-                tex = bulletTexture[1];
+                tex = &bulletSheet[1];
                 frameW = 1667; frameH = 1167; totalFrames = 4;
-                animSpeed = 0.05f; scale = 0.1f;
-
-                b.initCollisionEffect(getContext().textures->get(Textures::FireImpact), (float)283 / 5, 44, 5, 0.09f, 1.7f);
-                b1.initCollisionEffect(getContext().textures->get(Textures::FireImpact), (float)283 / 5, 44, 5, 0.09f, 1.7f);
-
+                animSpeed = 0.05f; scale = GameConstants::FIRE_BULLET_SCALE;
                 break;
 
             case 5: // Tower type 3 - Upgraded - Ice
-                tex = bulletTexture[2];
+                tex = &bulletSheet[2];
                 frameW = 141; frameH = 114; totalFrames = 5;
                 animSpeed = 0.05f; scale = 0.8f;
-
-                b.initCollisionEffect(getContext().textures->get(Textures::IceImpact), (float)388 / 6, 69, 6, 0.09f, 1.4f);
-                b1.initCollisionEffect(getContext().textures->get(Textures::IceImpact), (float)388 / 6, 69, 6, 0.09f, 1.4f);
-
                 break;
 
             default:
-                tex = bulletTexture[0];
+                tex = &bulletSheet[0];
                 frameW = 16; frameH = 15; totalFrames = 7;
                 animSpeed = 0.05f; scale = 4.f;
                 break;
@@ -990,11 +917,12 @@ bool GameState::update(Time dt)
             }
             else b.setDamage(1);
 
+            b.setImpactEffect(impactEffect[t % 3]);
+            b1.setImpactEffect(impactEffect[t % 3]);
+
             bullets.push_back(b);
             if (tower.getType() == 3 || tower.getType() == 4 || tower.getType() == 5) bullets.push_back(b1);
         }
-
-        tower.updateEffect(dt.asSeconds());
     }
 
     // Bullet logic: track and hit enemies
@@ -1011,7 +939,8 @@ bool GameState::update(Time dt)
                     bulletBombSound.play();
                 }
 
-                b.triggerCollision(enemies[idx].getX(), enemies[idx].getY());
+                effects.spawn(b.getImpactEffect(), Vector2f(enemies[idx].getX(), enemies[idx].getY() - 20.f));
+                b.deactivate();
                 enemies[idx].takeDamage(b.getDamage());
             }
 
@@ -1020,79 +949,117 @@ bool GameState::update(Time dt)
                 b.updateAnimation(dt.asSeconds());
             }
         }
-
-        b.updateCollision(dt.asSeconds());
     }
+    effects.update(dt.asSeconds());
 
-    // Update powerStations animation
-    curMap->updatePowerStation(dt.asSeconds());
+    // Update power stations and other ambient animation
+    curMap->updateProps(dt.asSeconds());
 
-    // Remove inactive bullets
+    // Remove spent bullets, their impacts play on in the effect pool
     bullets.erase(remove_if(bullets.begin(), bullets.end(),
         [](cbullet& b) { return b.isRemovable(); }), bullets.end());
 
-    // Update mainTower hp & gold
-    hp.setString(to_string(curMap->getMainTower().getHealth()));
-    gold.setString(to_string(player.getMoney()));
-    wave.setString(to_string(levels[currentLevelIndex].getCurrentWaveIndex() + 1) + "/" + to_string(levels[currentLevelIndex].getWaveCount()));
-
     // Turn off toast after 1s
     if (showNotEnough && notEnoughClock.getElapsedTime().asSeconds() > NOT_ENOUGH_DURATION)
         showNotEnough = false;
 
+    refreshHud();
+
     return true;
 }
 
 void GameState::loadLevel(int index) {
     RenderWindow& window = *getContext().window;
 
-    if (index < 0 || index >= levels.size()) return;
+    if (index < 0 || index >= LevelRegistry::LEVEL_COUNT) return;
 
     currentLevelIndex = index;
 
-    // Load map & pathfinding
-    curMap = &levels[currentLevelIndex].getMap();
-    cenemy& ce = curMap->getEnemy();
-    ce.findPath(curMap->getMap(), ce.getStart(), ce.getEnd());
-
-    // Load map data & texture & mainTowerMaxHealth for the current level
+    // Build only the selected level, its mapped file is cached by the registry
+    curLevel.reset(new clevel(index + 1, LevelRegistry::get(index)));
+    curMap = &curLevel->getMap();
 
-    levels[currentLevelIndex].loadMap(mainTowerTexture, backgroundTexture[index], currentLevelIndex + 1);
-    backgroundSprite.setTexture(*backgroundTexture[currentLevelIndex]);
-    window.setSize(backgroundTexture[currentLevelIndex]->getSize());
+    // Load map data, enemy path & texture & mainTowerMaxHealth for the current level
+    // Only this level's background is resident, the others load when played
+    backgroundTexture = &acquireTexture(static_cast<Textures::ID>(Textures::Map1 + index));
+    curLevel->loadMap(mainTowerTexture, backgroundTexture);
+    backgroundSprite.setTexture(*backgroundTexture);
+    window.setSize(backgroundTexture->getSize());
 
     // Load powerStation effect for this level
-    const Texture& powerStationTex = getContext().textures->get(Textures::powerStation);
-    string powerStationFiles = "Media/Text files/powerStation_map" + to_string(currentLevelIndex + 1) + ".txt";
-    curMap->loadPowerStationsFromFile(powerStationTex, powerStationFiles, 92, 92, 0.03f);
-
-    // Apply the position to the tower sprite
-    curMap->getMainTower().getPosition();
+    curMap->loadPowerStations(getContext().textures->getRegion(Textures::powerStation), 92, 92, 0.03f);
+
+    // Construction icons never move, place them once
+    MapHandle::setIconsmap(*curMap, constructionicons);
+    staticLayer.create(backgroundTexture->getSize());
+
+    // Build the HUD once, update() then only pushes values into it
+    Text valueText;
+    valueText.setFont(font);
+    valueText.setCharacterSize(30);
+    valueText.setFillColor(Color::White);
+
+    hud.clear();
+    hud.create(backgroundTexture->getSize());
+    hud.addSprite(heartIcon);
+    hud.addSprite(currencyIcon);
+    hud.addSprite(waveIcon);
+    valueText.setPosition(160.f, 60.f);
+    hudHp = hud.addText(valueText, true);
+    valueText.setPosition(410.f, 60.f);
+    hudGold = hud.addText(valueText, true);
+    valueText.setPosition(160.f, 130.f);
+    hudWave = hud.addText(valueText, true);
+    hudToast = hud.addText(notEnoughText, false);
+
+    reset();
+}
 
+// Puts the loaded level back to its starting state (or the saved progress) without
+// touching textures, sounds or the level data, so a restart takes a single frame
+void GameState::reset() {
     // Reset enemy, tower, bullet...
+    spawner.stop();
     enemies.clear();
     towers.clear();
     bullets.clear();
+    effects.clear();
+    enemyOrder.clear();
+    enemyProgress.clear();
+
+    // Free every tower slot and restore the base to full health
+    curMap->resetTiles();
+    for (int i = 0; i < LevelFile::MAX_SLOTS; ++i)
+        towerconstructed[i] = false;
+    staticLayer.invalidate();
+    curMap->getMainTower().setHealth(curMap->getMainTower().getMaxHealth());
 
     // Reset game flags and wave index
     isGameOver = false;
     isGameWin = false;
     hasPressedPlay = false; // Reset play state for new level
+    waveIndex = 0;
+
+    // Close any open tower menu
+    showInfo = false;
+    showTowerRange = false;
+    isChoosingTower = false;
+    showNotEnough = false;
+    selectedinfo = -1;
 
     // SaveManagement: Load wave, health, gold
     int loadWave = SaveManagement::playerResult[currentLevelIndex].curWave;
     int loadHealth = SaveManagement::playerResult[currentLevelIndex].health;
     int loadGold = SaveManagement::playerResult[currentLevelIndex].curGold;
 
-    levels[currentLevelIndex].setCurrentWaveIndex(loadWave);            // wave
+    curLevel->setCurrentWaveIndex(loadWave);            // wave
 
     if (loadHealth != 0)                                                // health
         curMap->getMainTower().setCurrentHealth(loadHealth);
     curMap->getMainTower().takeDamage(0);
-    curMap->getMainTower().drawHealthBar(window);
 
     if (loadGold == 0)                                                  // gold
-        player.setMoney(levels[currentLevelIndex].getStartGold());
+        player.setMoney(curLevel->getStartGold());
     else if (loadGold == -1)
         player.setMoney(0);
     else
@@ -1107,84 +1074,112 @@ void GameState::loadLevel(int index) {
         cpoint tLoc = SaveManagement::playerResult[currentLevelIndex].towers[i].getLocation();
 
         tTower.setType(tType);
-        switch (tType) {
-        case 0: tTower.initEffect(getContext().textures->get(Textures::BombShootEffect), 30, 23, 5, 0.05f); break;
-        case 1: tTower.initEffect(getContext().textures->get(Textures::FireShootEffect), 30, 23, 5, 0.05f); break;
-        case 2: tTower.initEffect(getContext().textures->get(Textures::IceShootEffect), 30, 23, 5, 0.05f); break;
-        }
         tTower.setLocation(tLoc);
-        int itower = MapHandle::findBlockmap(currentLevelIndex, tLoc.getRow(), tLoc.getCol());
-        tTower.init(*towerTexture[tType],
+        int itower = MapHandle::findBlockmap(*curMap, tLoc.getRow(), tLoc.getCol());
+        tTower.init(towerSheet[tType],
             tLoc.getPixelX(),
-            tLoc.getPixelY(), currentLevelIndex, itower);
-        tTower.setMapForBullet(curMap->getMap());
+            tLoc.getPixelY(), curMap->getSlot(itower));
+        tTower.setMapForBullet(curMap->getTiles());
         tTower.getBullet().setSpeed(8);
-        int index = MapHandle::findBlockmap(currentLevelIndex, tLoc.getRow(), tLoc.getCol());
-        towerconstructed[index] = true;
+        int index = MapHandle::findBlockmap(*curMap, tLoc.getRow(), tLoc.getCol());
+        setConstructed(index, true);
 
+        tTower.computeCoverage(curMap->getPath(), TOWER_RANGE);
         towers.push_back(tTower);
 
-        MapHandle::setCmap(currentLevelIndex, *curMap, tLoc.getRow(), tLoc.getCol(), tType + 3);
+        MapHandle::setSlotTower(*curMap, tLoc.getRow(), tLoc.getCol(), tType);
     }
 
-    // Set up text to display main tower hp (demo)
-    hp.setFont(font);
-    hp.setCharacterSize(30);
-    hp.setFillColor(Color::White);
-    hp.setPosition(160.f, 60.f);
-    hp.setString(to_string(curMap->getMainTower().getHealth()));
-    centerOrigin(hp);
-
-    // Set up text to display gold (demo)
-    gold.setFont(font);
-    gold.setCharacterSize(30);
-    gold.setFillColor(Color::White);
-    gold.setPosition(410.f, 60.f);
-    gold.setString(to_string(player.getMoney()));
-    centerOrigin(gold);
-
-    // Set up text to display current wave index
-    wave.setFont(font);
-    wave.setCharacterSize(30);
-    wave.setString(to_string(levels[currentLevelIndex].getCurrentWaveIndex() + 1) + "/" + to_string(levels[currentLevelIndex].getWaveCount()));
-    wave.setFillColor(Color::White);
-    wave.setPosition(160.f, 130.f);
-    centerOrigin(wave);
-
-    MapHandle::initTowerButtonData();
+    refreshHud();
+}
+
+// Pushes the current values, the HUD only re-lays out the ones that changed
+void GameState::refreshHud() {
+    hud.setNumber(hudHp, curMap->getMainTower().getHealth());
+    hud.setNumber(hudGold, player.getMoney());
+    hud.setFraction(hudWave, curLevel->getCurrentWaveIndex() + 1, curLevel->getWaveCount());
+    hud.setVisible(hudToast, showNotEnough);
+}
+
+// Construction icons live in the static layer, so it is redrawn when one appears or goes
+void GameState::setConstructed(int slot, bool built) {
+    if (towerconstructed[slot] == built) return;
+    towerconstructed[slot] = built;
+    staticLayer.invalidate();
 }
 
+// Start the current wave's timeline, releaseEnemies brings the enemies in over time
 void GameState::spawnEnemies() {
-    // Get the current level and its wave information
-    const auto& waves = levels[currentLevelIndex].getWaves();
-    if (waveIndex >= waves.size()) return;
+    if (waveIndex >= curLevel->getWaveCount()) return;
 
-    clevel& level = levels[currentLevelIndex];
+    spawner.start(curLevel->getFile(), curLevel->getCurrentWaveIndex());
+    waveIndex++; // Update wave
+}
+
+void GameState::releaseEnemies(float dt) {
+    dueEnemies.clear();
+    spawner.update(dt, dueEnemies);
 
-    pair<EnemyType, int> info = level.getCurrentWaveInfo();
-    EnemyType type = info.first;
-    int count = info.second;
     cenemy& ce = curMap->getEnemy();
+    const cpath& path = curMap->getPath();
+    sf::Vector2f startPos = path.getStart();
 
-    for (int i = 0; i < count; i++) {
+    for (const cspawner::Spawn& s : dueEnemies) {
         cenemy enemy;
-        enemy.loadFromData(enemyData[type]);
+        enemy.loadFromData(enemyData[s.type]);
 
         enemy.setStart(ce.getStart());
         enemy.setEnd(ce.getEnd());
-        enemy.findPath(curMap->getMap(), ce.getStart(), ce.getEnd());
-
-        // Offset enemies so they don't overlap
-        cpoint startPoint = ce.getP()[0];
-        float pixelX = startPoint.getPixelX() - i * 120.f;
-        float pixelY = startPoint.getPixelY();
 
-        enemy.init(type, pixelX, pixelY, enemy.getHealthByType(type), enemyData[type]);
-        enemy.setCurr(startPoint);
+        // Enemies enter at the path start, moved on by however late this tick is
+        enemy.init(s.type, startPos.x, startPos.y, s.health, enemyData[s.type]);
+        enemy.setPath(&path, s.distance);
+        enemy.setCurr(ce.getStart());
         enemies.push_back(enemy);
     }
+}
 
-    waveIndex++; // Update wave
+// Order living enemies by how far they have walked, so every tower can pick its target
+// with a binary search over its coverage intervals instead of scanning all enemies
+void GameState::sortEnemiesByProgress() {
+    enemyOrder.clear();
+    for (int i = 0; i < enemies.size(); i++)
+        if (!enemies[i].hasReachedEnd() && !enemies[i].isDead())
+            enemyOrder.push_back(i);
+
+    sort(enemyOrder.begin(), enemyOrder.end(),
+        [this](int a, int b) { return enemies[a].getDistance() < enemies[b].getDistance(); });
+
+    enemyProgress.resize(enemyOrder.size());
+    for (int i = 0; i < enemyOrder.size(); i++)
+        enemyProgress[i] = enemies[enemyOrder[i]].getDistance();
+}
+
+int GameState::findTarget(const ctower& tower) const {
+    int best = -1;
+
+    for (const auto& c : tower.getCoverage()) {
+        // Enemies inside this interval are enemyOrder[from, to)
+        int from = lower_bound(enemyProgress.begin(), enemyProgress.end(), c.first) - enemyProgress.begin();
+        int to = upper_bound(enemyProgress.begin(), enemyProgress.end(), c.second) - enemyProgress.begin();
+        if (from >= to) continue;
+
+        switch (tower.getTargetMode()) {
+        case TARGET_FIRST: // Furthest along the path
+            if (best == -1 || to - 1 > best) best = to - 1;
+            break;
+        case TARGET_LAST: // Least far along the path
+            if (best == -1 || from < best) best = from;
+            break;
+        case TARGET_STRONGEST: // Most health, only enemies in range are visited
+            for (int i = from; i < to; i++)
+                if (best == -1 || enemies[enemyOrder[i]].getHealth() > enemies[enemyOrder[best]].getHealth())
+                    best = i;
+            break;
+        }
+    }
+
+    return best == -1 ? -1 : enemyOrder[best];
 }
 
 int GameState::calStars() {
@@ -12,8 +12,17 @@
 #include "MapHandle.h"
 #include "Player.h"
 #include "SaveManagement.h"
+#include "LevelRegistry.h"
+#include "cspawner.h"
+#include "HealthBarBatch.h"
+#include "RenderQueue.h"
+#include "EffectSystem.h"
+#include "StaticLayer.h"
+#include "HudLayer.h"
+#include "ViewCuller.h"
 #include <vector>
 #include <map>
+#include <memory>
 #include <cmath>
 #include <SFML/Graphics.hpp>
 #include <SFML/Graphics/View.hpp>
@@ -36,18 +45,53 @@ private:
     Event event;
 
     void loadLevel(int index);
+    void reset();
+    void setConstructed(int slot, bool built);
+    void drawStaticLayer();
+    void spawnShootEffect(ctower& tower);
+    void refreshHud();
     void spawnEnemies();
+    void releaseEnemies(float dt);
+    void sortEnemiesByProgress();
+    int findTarget(const ctower& tower) const;
     int calStars();
 
     Sprite backgroundSprite;
 
-    Font font;
-    Text hp, gold, wave;
+    // Background, unbuilt construction icons and main tower, redrawn only
+    // when a slot is built on or freed
+    StaticLayer staticLayer;
+
+    const Font& font; // Shared with FontHolder, never copied
+
+    // Icons, hp, gold, wave counter and toast; text is re-laid out only on change
+    HudLayer hud;
+    size_t hudHp, hudGold, hudWave, hudToast;
 
     vector<cenemy> enemies;
     vector<ctower> towers;
     vector<cbullet> bullets;
-    vector<clevel> levels;
+    unique_ptr<clevel> curLevel; // Only the level being played is built
+
+    // Current wave's timeline, enemies enter the game as they become due
+    cspawner spawner;
+    vector<cspawner::Spawn> dueEnemies;
+
+    // World sprites of a frame; units share a layer so towers and enemies overlap by screen y.
+    // Muzzle flashes sit above the units, impacts sort by y with the projectiles
+    enum RenderLayer { LayerUnits, LayerEffects, LayerProjectiles };
+    ViewCuller culler; // Area of the game view, off-view entities are neither updated nor drawn
+    RenderQueue renderQueue;
+
+    // Muzzle flashes and impacts, spawned and forgotten; kinds per base tower type
+    EffectSystem effects;
+    int shootEffect[3];
+    int impactEffect[3];
+    HealthBarBatch healthBars; // Main tower and enemy hp bars, one draw
+
+    // Living enemies sorted by path distance, rebuilt every tick for targeting
+    vector<int> enemyOrder;
+    vector<float> enemyProgress;
 
     cmap* curMap;
     int currentLevelIndex;
@@ -59,9 +103,9 @@ private:
     bool hasPressedPlay = false;
 
     map<EnemyType, EnemyAnimationData> enemyData;
-    Texture* backgroundTexture[4];
-    Texture* towerTexture[6];
-    Texture* bulletTexture[6];
+    Texture* backgroundTexture; // Held by this state, see loadLevel()
+    TextureRegion towerSheet[6];
+    TextureRegion bulletSheet[6];
     Texture* mainTowerTexture;
 
     // UI
@@ -77,8 +121,8 @@ private:
     CircleShape circleRange;
 
     // Construction Icons
-    Sprite constructionicons[7];
-    bool towerconstructed[7];
+    Sprite constructionicons[LevelFile::MAX_SLOTS];
+    bool towerconstructed[LevelFile::MAX_SLOTS];
 
     // Tower Infos
     Texture* infoTexture[6];
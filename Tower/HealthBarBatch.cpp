@@ -0,0 +1,100 @@
+#include "HealthBarBatch.h"
+#include <algorithm>
+
+bool HealthBarBatch::Bar::operator==(const Bar& other) const
+{
+    return area == other.area && percent == other.percent && back == other.back && fill == other.fill;
+}
+
+HealthBarBatch::HealthBarBatch()
+    : mCount(0)
+    , mBuffer(sf::Triangles, sf::VertexBuffer::Stream)
+    , mDirtyBegin(0)
+    , mDirtyEnd(0)
+{
+}
+
+void HealthBarBatch::begin()
+{
+    mCount = 0;
+}
+
+void HealthBarBatch::add(const sf::FloatRect& area, float percent, sf::Color back, sf::Color fill)
+{
+    Bar bar = { area, std::max(0.f, std::min(1.f, percent)), back, fill };
+    std::size_t i = mCount++;
+
+    if (i < mBars.size())
+    {
+        if (mBars[i] == bar)
+            return; // Unchanged since last frame, vertices are still valid
+        mBars[i] = bar;
+    }
+    else
+    {
+        mBars.push_back(bar);
+        mVertices.resize(mBars.size() * VERTICES_PER_BAR);
+    }
+
+    std::size_t first = i * VERTICES_PER_BAR;
+    writeQuad(first, area.left, area.top, area.width, area.height, back);
+    writeQuad(first + 6, area.left, area.top, area.width * bar.percent, area.height, fill);
+
+    if (mDirtyBegin == mDirtyEnd)
+        mDirtyBegin = i;
+    mDirtyBegin = std::min(mDirtyBegin, i);
+    mDirtyEnd = std::max(mDirtyEnd, i + 1);
+}
+
+void HealthBarBatch::upload() const
+{
+    if (mBuffer.getVertexCount() < mVertices.size())
+    {
+        // The buffer grew, everything in it has to be sent again
+        if (!mBuffer.create(mVertices.capacity()))
+            return;
+        mDirtyBegin = 0;
+        mDirtyEnd = mBars.size();
+    }
+
+    if (mDirtyBegin < mDirtyEnd)
+    {
+        std::size_t first = mDirtyBegin * VERTICES_PER_BAR;
+        mBuffer.update(&mVertices[first], (mDirtyEnd - mDirtyBegin) * VERTICES_PER_BAR, (unsigned)first);
+    }
+    mDirtyBegin = mDirtyEnd = 0;
+}
+
+void HealthBarBatch::writeQuad(std::size_t first, float left, float top, float width, float height, sf::Color color)
+{
+    sf::Vertex* v = &mVertices[first];
+    sf::Vector2f topLeft(left, top), topRight(left + width, top);
+    sf::Vector2f bottomLeft(left, top + height), bottomRight(left + width, top + height);
+
+    v[0] = sf::Vertex(topLeft, color);
+    v[1] = sf::Vertex(bottomLeft, color);
+    v[2] = sf::Vertex(topRight, color);
+    v[3] = sf::Vertex(topRight, color);
+    v[4] = sf::Vertex(bottomLeft, color);
+    v[5] = sf::Vertex(bottomRight, color);
+}
+
+void HealthBarBatch::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+    if (mCount == 0)
+        return;
+
+    states.texture = nullptr;
+    if (sf::VertexBuffer::isAvailable())
+    {
+        upload();
+        if (mBuffer.getVertexCount() >= mVertices.size())
+        {
+            target.draw(mBuffer, 0, mCount * VERTICES_PER_BAR, states);
+            return;
+        }
+    }
+
+    // No vertex buffer support, submit from client memory
+    target.draw(mVertices.data(), mCount * VERTICES_PER_BAR, sf::Triangles, states);
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Health bars of a frame as colored quads in one vertex buffer, drawn with a
+// single call. Bar i always owns the same vertices, and they are only
+// rewritten when its rectangle, fill or colors differ from the last frame;
+// only that changed range is then streamed to the GPU buffer.
+class HealthBarBatch
+{
+public:
+    HealthBarBatch();
+
+    void begin(); // Start a new frame, bars are then added in a stable order
+    void add(const sf::FloatRect& area, float percent, sf::Color back, sf::Color fill);
+    void draw(sf::RenderTarget& target, sf::RenderStates states = sf::RenderStates::Default) const;
+
+private:
+    struct Bar
+    {
+        sf::FloatRect area;
+        float percent;
+        sf::Color back, fill;
+
+        bool operator==(const Bar& other) const;
+    };
+
+    static const std::size_t VERTICES_PER_BAR = 12; // Background and fill quads
+
+    void writeQuad(std::size_t first, float left, float top, float width, float height, sf::Color color);
+    void upload() const;
+
+    std::vector<Bar> mBars;         // What each vertex block currently shows
+    std::vector<sf::Vertex> mVertices;
+    std::size_t mCount;             // Bars added this frame
+
+    mutable sf::VertexBuffer mBuffer;
+    mutable std::size_t mDirtyBegin, mDirtyEnd; // Bars rewritten since the last upload
+};
@@ -0,0 +1,93 @@
+#include "HudLayer.h"
+#include "Utility.h"
+#include <climits>
+#include <string>
+
+void HudLayer::create(sf::Vector2u size)
+{
+    mLayer.create(size);
+}
+
+void HudLayer::clear()
+{
+    mItems.clear();
+    mLayer.invalidate();
+}
+
+std::size_t HudLayer::addSprite(const sf::Sprite& sprite)
+{
+    Item item = { false, false, true, INT_MIN, INT_MIN, sprite, sf::Text() };
+    mItems.push_back(item);
+    mLayer.invalidate();
+    return mItems.size() - 1;
+}
+
+std::size_t HudLayer::addText(const sf::Text& text, bool centered)
+{
+    Item item = { true, centered, true, INT_MIN, INT_MIN, sf::Sprite(), text };
+    mItems.push_back(item);
+    mLayer.invalidate();
+    return mItems.size() - 1;
+}
+
+void HudLayer::setNumber(std::size_t text, int value)
+{
+    Item& item = mItems[text];
+    if (item.value == value && item.total == INT_MIN)
+        return;
+
+    item.value = value;
+    item.total = INT_MIN;
+    setString(item, std::to_string(value));
+}
+
+void HudLayer::setFraction(std::size_t text, int value, int total)
+{
+    Item& item = mItems[text];
+    if (item.value == value && item.total == total)
+        return;
+
+    item.value = value;
+    item.total = total;
+    setString(item, std::to_string(value) + "/" + std::to_string(total));
+}
+
+void HudLayer::setString(Item& item, const std::string& string)
+{
+    item.text.setString(string);
+    if (item.centered)
+        centerOrigin(item.text);
+    mLayer.invalidate();
+}
+
+void HudLayer::setVisible(std::size_t item, bool visible)
+{
+    if (mItems[item].visible == visible)
+        return;
+
+    mItems[item].visible = visible;
+    mLayer.invalidate();
+}
+
+void HudLayer::draw(sf::RenderTarget& target)
+{
+    if (mLayer.isDirty())
+    {
+        sf::RenderTarget& layer = mLayer.begin();
+        for (const Item& item : mItems)
+        {
+            if (!item.visible)
+                continue;
+            if (item.isText)
+                layer.draw(item.text);
+            else
+                layer.draw(item.sprite);
+        }
+        mLayer.end();
+    }
+
+    // Drawing onto a transparent texture premultiplies alpha, so blit without multiplying again
+    sf::RenderStates states;
+    states.blendMode = sf::BlendMode(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha);
+    mLayer.draw(target, states);
+}
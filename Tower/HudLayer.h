@@ -0,0 +1,41 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "StaticLayer.h"
+
+// Retained HUD: icons and texts are added once, values are pushed every
+// frame but a text is only re-laid out when its value actually changes.
+// The whole HUD is cached in a StaticLayer and costs one draw per frame
+// until something changes.
+class HudLayer
+{
+public:
+    void create(sf::Vector2u size);
+    void clear();
+
+    // Items draw in the order they are added and are returned as handles
+    std::size_t addSprite(const sf::Sprite& sprite);
+    std::size_t addText(const sf::Text& text, bool centered); // Centered texts re-center on change
+
+    void setNumber(std::size_t text, int value);             // "value"
+    void setFraction(std::size_t text, int value, int total); // "value/total"
+    void setVisible(std::size_t item, bool visible);
+
+    void draw(sf::RenderTarget& target);
+
+private:
+    struct Item
+    {
+        bool isText;
+        bool centered;
+        bool visible;
+        int value, total; // Shown by the text, to skip unchanged updates
+        sf::Sprite sprite;
+        sf::Text text;
+    };
+
+    void setString(Item& item, const std::string& string);
+
+    std::vector<Item> mItems;
+    StaticLayer mLayer;
+};
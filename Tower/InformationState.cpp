@@ -29,8 +29,9 @@ static sf::FloatRect makeLetterboxViewport(sf::Vector2u winSize)
 
 InformationState::InformationState(StateStack& stack, Context context)
 	: State(stack, context)
+	, mFont(context.fonts->get(Fonts::KnightWarrior))
 {
-	sf::Texture& texture = context.textures->get(Textures::infoPanel);
+	sf::Texture& texture = acquireTexture(Textures::infoPanel);
 	mBackgroundSprite.setTexture(texture);
 	mBackgroundSprite.setPosition(0.f, 0.f);
 
@@ -44,9 +45,6 @@ InformationState::InformationState(StateStack& stack, Context context)
 	mCloseInfoButton.setPosition(1400.f, 290.f);
 	centerOrigin(mCloseInfoButton);
 
-	// Font
-	mFont = context.fonts->get(Fonts::KnightWarrior);
-
 	// These coordinates should match the box in your background image
 	const sf::Vector2f textAreaPosition(640.f, 300.f);  // Top-left of visible box
 	const sf::Vector2f textAreaSize(770.f, 440.f);     // Dimensions of visible box
@@ -23,7 +23,7 @@ private:
     sf::Sprite mCloseInfoButton;
     sf::RectangleShape mScrollArea;
 
-    sf::Font mFont;  // Store font as member
+    const sf::Font& mFont;  // Shared with FontHolder, never copied
     std::vector<sf::Text> mInfoTexts;
 
     float mScrollOffset = 0.f;
@@ -0,0 +1,136 @@
+#include "LevelFile.h"
+#include "cpoint.h"
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+    // True when count records of the given size starting at offset fit in the file
+    bool fits(uint32_t offset, uint32_t count, std::size_t recordSize, std::size_t fileSize)
+    {
+        if (offset % 4 != 0 || offset > fileSize)
+            return false;
+        return count <= (fileSize - offset) / recordSize;
+    }
+
+    bool inGrid(const LevelHeader& header, int row, int col)
+    {
+        return row >= 0 && row < header.rows && col >= 0 && col < header.cols;
+    }
+}
+
+LevelFile::LevelFile()
+    : mHeader(nullptr), mGrid(nullptr), mSlots(nullptr), mStations(nullptr), mWaves(nullptr)
+    , mGroups(nullptr), mPath(nullptr)
+{
+}
+
+void LevelFile::open(const std::string& filename)
+{
+    close();
+
+    if (!mFile.open(filename))
+        throw std::runtime_error("LevelFile::open - Failed to open " + filename);
+
+    const unsigned char* data = mFile.data();
+    std::size_t size = mFile.size();
+    const LevelHeader* header = reinterpret_cast<const LevelHeader*>(data);
+
+    if (size < sizeof(LevelHeader) || std::memcmp(header->magic, "TDLV", 4) != 0)
+        throw std::runtime_error("LevelFile::open - Not a level file " + filename);
+    if (header->version != VERSION)
+        throw std::runtime_error("LevelFile::open - Unsupported level version in " + filename);
+    if (header->fileSize != size
+        || !fits(header->gridOffset, header->rows * header->cols, 1, size)
+        || !fits(header->slotOffset, header->slotCount, sizeof(LevelSlot), size)
+        || !fits(header->stationOffset, header->stationCount, sizeof(LevelStation), size)
+        || !fits(header->waveOffset, header->waveCount, sizeof(LevelWave), size)
+        || !fits(header->groupOffset, header->groupCount, sizeof(LevelWaveGroup), size)
+        || !fits(header->pathOffset, header->pathCount, sizeof(LevelPathTile), size))
+        throw std::runtime_error("LevelFile::open - Truncated level file " + filename);
+    if (header->slotCount > MAX_SLOTS)
+        throw std::runtime_error("LevelFile::open - Too many tower slots in " + filename);
+    if (header->pathCount == 0)
+        throw std::runtime_error("LevelFile::open - No enemy path in " + filename);
+    if (header->waveCount == 0)
+        throw std::runtime_error("LevelFile::open - No waves in " + filename);
+
+    const LevelWave* waves = reinterpret_cast<const LevelWave*>(data + header->waveOffset);
+    for (uint32_t i = 0; i < header->waveCount; ++i)
+        if (waves[i].firstGroup > header->groupCount || waves[i].groupCount > header->groupCount - waves[i].firstGroup)
+            throw std::runtime_error("LevelFile::open - Wave groups out of range in " + filename);
+
+    // Groups pick the enemy's animation data by type, and scale its health
+    const LevelWaveGroup* groups = reinterpret_cast<const LevelWaveGroup*>(data + header->groupOffset);
+    for (uint32_t i = 0; i < header->groupCount; ++i)
+    {
+        const LevelWaveGroup& g = groups[i];
+        if (g.enemyType < 0 || g.enemyType >= ENEMY_TYPES || g.count <= 0
+            || !std::isfinite(g.hpScale) || g.hpScale <= 0.f
+            || !std::isfinite(g.cadence) || g.cadence < 0.f
+            || !std::isfinite(g.delay) || g.delay < 0.f)
+            throw std::runtime_error("LevelFile::open - Bad wave group in " + filename);
+    }
+
+    // Everything below indexes the tile grids directly, so no coordinate may leave them
+    if (!inGrid(*header, header->spawnRow, header->spawnCol)
+        || !inGrid(*header, header->goalRow, header->goalCol)
+        || !inGrid(*header, header->baseRow, header->baseCol))
+        throw std::runtime_error("LevelFile::open - Spawn, goal or base off the grid in " + filename);
+
+    const LevelSlot* slots = reinterpret_cast<const LevelSlot*>(data + header->slotOffset);
+    for (uint32_t i = 0; i < header->slotCount; ++i)
+    {
+        const LevelSlot& s = slots[i];
+        if (s.top > s.bottom || s.left > s.right
+            || !inGrid(*header, s.top, s.left) || !inGrid(*header, s.bottom, s.right)
+            || s.anchorRow < s.top || s.anchorRow > s.bottom || s.anchorCol < s.left || s.anchorCol > s.right)
+            throw std::runtime_error("LevelFile::open - Tower slot off the grid in " + filename);
+    }
+
+    const LevelStation* stations = reinterpret_cast<const LevelStation*>(data + header->stationOffset);
+    float width = (float)header->cols * cpoint::TILE_SIZE, height = (float)header->rows * cpoint::TILE_SIZE;
+    for (uint32_t i = 0; i < header->stationCount; ++i)
+        if (!(stations[i].x >= 0.f && stations[i].x <= width && stations[i].y >= 0.f && stations[i].y <= height))
+            throw std::runtime_error("LevelFile::open - Power station off the map in " + filename);
+
+    const LevelPathTile* path = reinterpret_cast<const LevelPathTile*>(data + header->pathOffset);
+    for (uint32_t i = 0; i < header->pathCount; ++i)
+        if (!inGrid(*header, path[i].row, path[i].col))
+            throw std::runtime_error("LevelFile::open - Enemy path off the grid in " + filename);
+
+    // cpath expects a connected route, one 4-neighbour step per tile
+    for (uint32_t i = 1; i < header->pathCount; ++i)
+        if (std::abs(path[i].row - path[i - 1].row) + std::abs(path[i].col - path[i - 1].col) != 1)
+            throw std::runtime_error("LevelFile::open - Enemy path is not connected in " + filename);
+
+    mHeader = header;
+    mGrid = data + header->gridOffset;
+    mSlots = slots;
+    mStations = stations;
+    mWaves = waves;
+    mGroups = groups;
+    mPath = path;
+}
+
+void LevelFile::close()
+{
+    mFile.close();
+    mHeader = nullptr;
+    mGrid = nullptr;
+    mSlots = nullptr;
+    mStations = nullptr;
+    mWaves = nullptr;
+    mGroups = nullptr;
+    mPath = nullptr;
+}
+
+int LevelFile::enemyCount(int wave) const
+{
+    const LevelWave& w = mWaves[wave];
+    int count = 0;
+    for (uint32_t i = 0; i < w.groupCount; ++i)
+        count += mGroups[w.firstGroup + i].count;
+    return count;
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "MappedFile.h"
+#include <cstdint>
+#include <string>
+
+// Binary level format (.lvl), little-endian, every record 4-byte aligned so the
+// mapped file can be read through these structs directly:
+//
+//   LevelHeader
+//   uint8_t  grid[rows * cols]       tile flags, row-major, padded to 4 bytes
+//   LevelSlot    slots[slotCount]
+//   LevelStation stations[stationCount]
+//   LevelWave    waves[waveCount]
+//   LevelWaveGroup groups[groupCount] every wave owns a contiguous run of groups
+//   LevelPathTile path[pathCount]    spawn to goal, both included
+//
+// Offsets in the header are from the start of the file. Files are written by
+// the LevelCompiler tool from the text sources in Media/Levels/Source, which
+// also validates them. Bump VERSION whenever a record changes layout.
+
+enum LevelTileFlags : uint8_t
+{
+    TILE_WALKABLE = 1 << 0, // Enemy path
+    TILE_BUILDABLE = 1 << 1, // Part of a tower slot footprint
+};
+
+struct LevelHeader
+{
+    char magic[4];          // "TDLV"
+    uint32_t version;
+    uint32_t fileSize;
+    uint16_t rows, cols;
+    int16_t spawnRow, spawnCol; // Enemy start tile
+    int16_t goalRow, goalCol;   // Enemy end tile
+    int16_t baseRow, baseCol;   // Main tower tile
+    int32_t baseHealth;
+    int32_t startGold;
+    int32_t towerMax;
+    uint32_t gridOffset;
+    uint32_t slotOffset, slotCount;
+    uint32_t stationOffset, stationCount;
+    uint32_t waveOffset, waveCount;
+    uint32_t pathOffset, pathCount;
+    uint32_t groupOffset, groupCount;
+};
+
+// One tower slot: the buildable footprint, the tile the tower stands on and
+// where its construction icon and tower-choice buttons go
+struct LevelSlot
+{
+    int16_t top, left, bottom, right; // Footprint, inclusive
+    int16_t anchorRow, anchorCol;     // Tower tile
+    uint8_t flipped;                  // Icon and tower drawn anchored on their right side
+    uint8_t padding[3];
+    float towerOriginX, towerOriginY; // Tower sprite origin = texture size / these
+    float buttons[4][2];              // 3 tower buttons then the circle, in pixels
+};
+
+struct LevelStation
+{
+    float x, y;
+};
+
+struct LevelWave
+{
+    uint32_t firstGroup, groupCount;
+};
+
+// One run of enemies inside a wave. Groups of a wave run side by side, each
+// on its own clock starting when the wave starts
+struct LevelWaveGroup
+{
+    int32_t enemyType; // EnemyType
+    int32_t count;
+    float cadence;     // Seconds between two spawns, 0 = one enemy every 120 px of its speed
+    float delay;       // Seconds after the wave starts before the first spawn
+    float hpScale;     // Multiplies the enemy type's health
+};
+
+struct LevelPathTile
+{
+    int16_t row, col;
+};
+
+static_assert(sizeof(LevelHeader) == 84, "LevelHeader layout changed, bump LevelFile::VERSION");
+static_assert(sizeof(LevelSlot) == 56, "LevelSlot layout changed, bump LevelFile::VERSION");
+static_assert(sizeof(LevelStation) == 8, "LevelStation layout changed, bump LevelFile::VERSION");
+static_assert(sizeof(LevelWave) == 8, "LevelWave layout changed, bump LevelFile::VERSION");
+static_assert(sizeof(LevelWaveGroup) == 20, "LevelWaveGroup layout changed, bump LevelFile::VERSION");
+static_assert(sizeof(LevelPathTile) == 4, "LevelPathTile layout changed, bump LevelFile::VERSION");
+
+class LevelFile
+{
+public:
+    static const uint32_t VERSION = 4;
+    static const int MAX_SLOTS = 7;
+    static const int ENEMY_TYPES = 3; // Valid LevelWaveGroup::enemyType values are below this
+
+public:
+    LevelFile();
+
+    // Maps the file and checks the header, offsets and every coordinate against the grid;
+    // throws std::runtime_error if it is not a valid level
+    void open(const std::string& filename);
+    void close();
+    bool isOpen() const { return mHeader != nullptr; }
+
+    const LevelHeader& header() const { return *mHeader; }
+    uint8_t tile(int row, int col) const { return mGrid[row * mHeader->cols + col]; }
+
+    int slotCount() const { return static_cast<int>(mHeader->slotCount); }
+    const LevelSlot& slot(int i) const { return mSlots[i]; }
+
+    int stationCount() const { return static_cast<int>(mHeader->stationCount); }
+    const LevelStation& station(int i) const { return mStations[i]; }
+
+    int waveCount() const { return static_cast<int>(mHeader->waveCount); }
+    const LevelWave& wave(int i) const { return mWaves[i]; }
+    const LevelWaveGroup& group(int i) const { return mGroups[i]; }
+    int enemyCount(int wave) const; // Enemies over all groups of a wave
+
+    // Baked enemy route, see LevelCompiler
+    int pathLength() const { return static_cast<int>(mHeader->pathCount); }
+    const LevelPathTile& pathTile(int i) const { return mPath[i]; }
+
+private:
+    MappedFile mFile;
+    const LevelHeader* mHeader;
+    const uint8_t* mGrid;
+    const LevelSlot* mSlots;
+    const LevelStation* mStations;
+    const LevelWave* mWaves;
+    const LevelWaveGroup* mGroups;
+    const LevelPathTile* mPath;
+};
@@ -0,0 +1,20 @@
+#include "LevelRegistry.h"
+#include <stdexcept>
+
+LevelFile LevelRegistry::mFiles[LevelRegistry::LEVEL_COUNT];
+
+std::string LevelRegistry::getFilename(int index)
+{
+    return "Media/Levels/level" + std::to_string(index + 1) + ".lvl";
+}
+
+const LevelFile& LevelRegistry::get(int index)
+{
+    if (index < 0 || index >= LEVEL_COUNT)
+        throw std::runtime_error("LevelRegistry::get - No level " + std::to_string(index));
+
+    LevelFile& file = mFiles[index];
+    if (!file.isOpen())
+        file.open(getFilename(index));
+    return file;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "LevelFile.h"
+#include <string>
+
+// Where the shipped levels live. Each level file is mapped the first time it is
+// asked for and stays mapped for the rest of the run, so entering or restarting
+// a level never touches the disk again and costs the same however many levels exist.
+class LevelRegistry
+{
+public:
+    static const int LEVEL_COUNT = 4;
+
+    static std::string getFilename(int index);
+    static const LevelFile& get(int index); // Throws std::runtime_error for an unknown or broken level
+
+private:
+    static LevelFile mFiles[LEVEL_COUNT];
+};
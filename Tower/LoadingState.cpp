@@ -0,0 +1,55 @@
+#include "LoadingState.h"
+#include "ResourceLoader.h"
+#include "Utility.h"
+
+#include <SFML/Graphics/RenderWindow.hpp>
+
+LoadingState::LoadingState(StateStack& stack, Context context)
+	: State(stack, context)
+{
+	sf::Vector2f center(960.f, 540.f);
+
+	mLoadingText.setFont(context.fonts->get(Fonts::BruceForever));
+	mLoadingText.setString("Loading");
+	mLoadingText.setCharacterSize(40);
+	centerOrigin(mLoadingText);
+	mLoadingText.setPosition(center.x, center.y - 60.f);
+
+	mProgressBarBackground.setSize(sf::Vector2f(800.f, 20.f));
+	mProgressBarBackground.setFillColor(sf::Color(60, 60, 60));
+	mProgressBarBackground.setPosition(center.x - 400.f, center.y);
+
+	mProgressBar.setSize(sf::Vector2f(0.f, 20.f));
+	mProgressBar.setFillColor(sf::Color(255, 200, 0));
+	mProgressBar.setPosition(mProgressBarBackground.getPosition());
+}
+
+void LoadingState::draw()
+{
+	sf::RenderWindow& window = *getContext().window;
+
+	// Same 1920x1080 canvas the menu is authored for
+	window.setView(sf::View(sf::FloatRect(0.f, 0.f, 1920.f, 1080.f)));
+	window.draw(mLoadingText);
+	window.draw(mProgressBarBackground);
+	window.draw(mProgressBar);
+}
+
+bool LoadingState::update(sf::Time)
+{
+	// Application::update already streams within its frame budget
+	ResourceLoader& loader = *getContext().loader;
+	mProgressBar.setSize(sf::Vector2f(800.f * loader.getProgress(Assets::Menu), 20.f));
+
+	if (loader.isReady(Assets::Menu))
+	{
+		requestStackPop();
+		requestStackPush(States::Menu);
+	}
+	return true;
+}
+
+bool LoadingState::handleEvent(const sf::Event&)
+{
+	return true;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "State.h"
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/Text.hpp>
+
+// First screen on the stack. It needs nothing but a font, so it shows at
+// once while the menu's assets stream in, then hands over to MenuState.
+// Later tiers keep streaming behind the menu.
+class LoadingState : public State
+{
+public:
+	LoadingState(StateStack& stack, Context context);
+
+	virtual void			draw();
+	virtual bool			update(sf::Time dt);
+	virtual bool			handleEvent(const sf::Event& event);
+
+
+private:
+	sf::Text				mLoadingText;
+	sf::RectangleShape		mProgressBarBackground;
+	sf::RectangleShape		mProgressBar;
+};
@@ -2,6 +2,8 @@
 #include "Utility.h"
 #include "Foreach.h"
 #include "ResourceHolder.h"
+#include "ResourceLoader.h"
+#include "LevelRegistry.h"
 
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Graphics/View.hpp>
@@ -10,9 +12,12 @@ int MapSelectionState::levelID = 0;
 
 MapSelectionState::MapSelectionState(StateStack& stack, Context context)
 	: State(stack, context)
+	, font(context.fonts->get(Fonts::BruceForever))
 {
+	context.loader->require(Assets::MapSelection); // Usually streamed in while the menu was up
+
 	// Set background
-	sf::Texture& texture = context.textures->get(Textures::mapSelectionBackground);
+	sf::Texture& texture = acquireTexture(Textures::mapSelectionBackground);
 	backgroundSprite.setTexture(texture);
 
 	// Load homebutton texture
@@ -22,51 +27,49 @@ MapSelectionState::MapSelectionState(StateStack& stack, Context context)
 
 	// Load unlocked map textures
 	sf::Sprite level1;
-	level1.setTexture(context.textures->get(Textures::miniMap1));
+	level1.setTexture(acquireTexture(Textures::miniMap1));
 	level1.setPosition(580.0f, 360.0f);
 	centerOrigin(level1);
 	unlockedLevels.push_back(level1);
 
 	sf::Sprite level2;
-	level2.setTexture(context.textures->get(Textures::miniMap2));
+	level2.setTexture(acquireTexture(Textures::miniMap2));
 	level2.setPosition(1380.0f, 360.0f);
 	centerOrigin(level2);
 	unlockedLevels.push_back(level2);
 
 	sf::Sprite level3;
-	level3.setTexture(context.textures->get(Textures::miniMap3));
+	level3.setTexture(acquireTexture(Textures::miniMap3));
 	level3.setPosition(580.0f, 800.0f);
 	centerOrigin(level3);
 	unlockedLevels.push_back(level3);
 
 	sf::Sprite level4;
-	level4.setTexture(context.textures->get(Textures::miniMap4));
+	level4.setTexture(acquireTexture(Textures::miniMap4));
 	level4.setPosition(1380.0f, 800.0f);
 	centerOrigin(level4);
 	unlockedLevels.push_back(level4);
 
 	// Load locked map textures (map 1 is always unlocked)
 	sf::Sprite level2Locked;
-	level2Locked.setTexture(context.textures->get(Textures::miniMap2Locked));
+	level2Locked.setTexture(acquireTexture(Textures::miniMap2Locked));
 	level2Locked.setPosition(1380.0f, 360.0f);
 	centerOrigin(level2Locked);
 	lockedLevels.push_back(level2Locked);
 
 	sf::Sprite level3Locked;
-	level3Locked.setTexture(context.textures->get(Textures::miniMap3Locked));
+	level3Locked.setTexture(acquireTexture(Textures::miniMap3Locked));
 	level3Locked.setPosition(580.0f, 800.0f);
 	centerOrigin(level3Locked);
 	lockedLevels.push_back(level3Locked);
 
 	sf::Sprite level4Locked;
-	level4Locked.setTexture(context.textures->get(Textures::miniMap4Locked));
+	level4Locked.setTexture(acquireTexture(Textures::miniMap4Locked));
 	level4Locked.setPosition(1380.0f, 800.0f);
 	centerOrigin(level4Locked);
 	lockedLevels.push_back(level4Locked);
 
 	// Load Text shown for 4 maps
-	font = getContext().fonts->get(Fonts::BruceForever);
-
 	for (int i = 0; i < 4; i++)
 	{
 		if (SaveManagement::playerResult[i].status == -1) // not done playing
@@ -85,25 +88,25 @@ MapSelectionState::MapSelectionState(StateStack& stack, Context context)
 
 			if (i == 0)
 			{
-				waveText.setString(temp + "/" + to_string(3));
+				waveText.setString(temp + "/" + to_string(LevelRegistry::get(i).waveCount()));
 				waveText.setPosition(560.0f, 550.0f);
 				waveIcon.setPosition(480.0f, 550.0f);
 			}
 			else if (i == 1)
 			{
-				waveText.setString(temp + "/" + to_string(3));
+				waveText.setString(temp + "/" + to_string(LevelRegistry::get(i).waveCount()));
 				waveText.setPosition(1360.0f, 550.0f);
 				waveIcon.setPosition(1280.0f, 550.0f);
 			}
 			else if (i == 2)
 			{
-				waveText.setString(temp + "/" + to_string(4));
+				waveText.setString(temp + "/" + to_string(LevelRegistry::get(i).waveCount()));
 				waveText.setPosition(560.0f, 990.0f);
 				waveIcon.setPosition(480.0f, 990.0f);
 			}
 			else if (i == 3)
 			{
-				waveText.setString(temp + "/" + to_string(5));
+				waveText.setString(temp + "/" + to_string(LevelRegistry::get(i).waveCount()));
 				waveText.setPosition(1360.0f, 990.f);
 				waveIcon.setPosition(1280.0f, 990.0f);
 			}
@@ -29,7 +29,7 @@ public:
     static int levelID;
 
 private:
-    Font                                            font;
+    const Font&                                     font; // Shared with FontHolder
     vector<sf::Text>                                currentWave;
     sf::Text                                        playerName;
 };
@@ -0,0 +1,121 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile()
+    : mData(nullptr), mSize(0), mFile(INVALID_HANDLE_VALUE), mMapping(nullptr)
+{
+}
+
+bool MappedFile::open(const std::string& filename)
+{
+    close();
+
+    mFile = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (mFile == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(mFile, &size) || size.QuadPart == 0)
+    {
+        close();
+        return false;
+    }
+
+    mMapping = CreateFileMappingA(mFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mMapping)
+    {
+        close();
+        return false;
+    }
+
+    mData = static_cast<const unsigned char*>(MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0));
+    if (!mData)
+    {
+        close();
+        return false;
+    }
+
+    mSize = static_cast<std::size_t>(size.QuadPart);
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (mData)
+        UnmapViewOfFile(mData);
+    if (mMapping)
+        CloseHandle(mMapping);
+    if (mFile != INVALID_HANDLE_VALUE)
+        CloseHandle(mFile);
+
+    mData = nullptr;
+    mSize = 0;
+    mMapping = nullptr;
+    mFile = INVALID_HANDLE_VALUE;
+}
+
+#else
+
+MappedFile::MappedFile()
+    : mData(nullptr), mSize(0), mFile(-1)
+{
+}
+
+bool MappedFile::open(const std::string& filename)
+{
+    close();
+
+    mFile = ::open(filename.c_str(), O_RDONLY);
+    if (mFile < 0)
+        return false;
+
+    struct stat info;
+    if (fstat(mFile, &info) != 0 || info.st_size == 0)
+    {
+        close();
+        return false;
+    }
+
+    void* data = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, mFile, 0);
+    if (data == MAP_FAILED)
+    {
+        close();
+        return false;
+    }
+
+    mData = static_cast<const unsigned char*>(data);
+    mSize = static_cast<std::size_t>(info.st_size);
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (mData)
+        munmap(const_cast<unsigned char*>(mData), mSize);
+    if (mFile >= 0)
+        ::close(mFile);
+
+    mData = nullptr;
+    mSize = 0;
+    mFile = -1;
+}
+
+#endif
+
+MappedFile::~MappedFile()
+{
+    close();
+}
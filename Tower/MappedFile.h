@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Read-only memory mapping of a whole file. The contents are used in place,
+// nothing is copied or parsed until the caller reads it.
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& filename);
+    void close();
+
+    bool isOpen() const { return mData != nullptr; }
+    const unsigned char* data() const { return mData; }
+    std::size_t size() const { return mSize; }
+
+private:
+    const unsigned char* mData;
+    std::size_t mSize;
+
+#ifdef _WIN32
+    void* mFile;
+    void* mMapping;
+#else
+    int mFile;
+#endif
+};
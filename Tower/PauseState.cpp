@@ -184,8 +184,6 @@ bool PauseState::handleEvent(const sf::Event& event)
 		// Restart button
 		if (restartButton.getGlobalBounds().contains(mousePos))
 		{
-			requestStateClear();
-
 			// Reset saved progress
 			int tCurLevel = MapSelectionState::levelID;
 			if (!SaveManagement::playerResult[tCurLevel].win)
@@ -197,7 +195,8 @@ bool PauseState::handleEvent(const sf::Event& event)
 			SaveManagement::playerResult[tCurLevel].towers.clear();
 			SaveManagement::save(SaveManagement::playerName);
 
-			requestStackPush(States::Game); // Back to current Game
+			*getContext().restartLevel = true;
+			requestStackPop(); // Back to current Game, reset in place
 			return true;
 		}
 
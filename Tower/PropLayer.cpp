@@ -0,0 +1,102 @@
+#include "PropLayer.h"
+
+int PropLayer::addClip(const Clip& clip)
+{
+    Group group;
+    group.texture = clip.sheet.texture;
+    group.clock.init(clip.frameWidth, clip.frameHeight, clip.frameTime, clip.frameCount, /*loop*/ true,
+        sf::Vector2i(clip.sheet.rect.left, clip.sheet.rect.top));
+    group.frame = group.clock.getFrameRect();
+    group.vertices.setPrimitiveType(sf::Triangles);
+    group.buffer.setPrimitiveType(sf::Triangles);
+    group.buffer.setUsage(sf::VertexBuffer::Dynamic);
+    group.uploaded = false;
+
+    mGroups.push_back(group);
+    return (int)mGroups.size() - 1;
+}
+
+void PropLayer::addProp(int group, sf::Vector2f position)
+{
+    Group& g = mGroups[group];
+    float w = (float)g.frame.width, h = (float)g.frame.height;
+
+    sf::Vector2f topLeft = position, topRight = position + sf::Vector2f(w, 0.f);
+    sf::Vector2f bottomLeft = position + sf::Vector2f(0.f, h), bottomRight = position + sf::Vector2f(w, h);
+
+    std::size_t first = g.vertices.getVertexCount();
+    g.vertices.append(sf::Vertex(topLeft));
+    g.vertices.append(sf::Vertex(bottomLeft));
+    g.vertices.append(sf::Vertex(topRight));
+    g.vertices.append(sf::Vertex(topRight));
+    g.vertices.append(sf::Vertex(bottomLeft));
+    g.vertices.append(sf::Vertex(bottomRight));
+    writeTexCoords(&g.vertices[first], g.frame);
+    g.uploaded = false;
+}
+
+void PropLayer::clear()
+{
+    mGroups.clear();
+}
+
+void PropLayer::update(float dt)
+{
+    for (Group& g : mGroups)
+    {
+        g.clock.update(dt);
+        if (g.clock.getFrameRect() == g.frame)
+            continue;
+
+        // One clock for the whole group, only the texture coordinates move
+        g.frame = g.clock.getFrameRect();
+        for (std::size_t i = 0; i < g.vertices.getVertexCount(); i += 6)
+            writeTexCoords(&g.vertices[i], g.frame);
+        g.uploaded = false;
+    }
+}
+
+void PropLayer::writeTexCoords(sf::Vertex* quad, const sf::IntRect& frame)
+{
+    float left = (float)frame.left, right = (float)(frame.left + frame.width);
+    float top = (float)frame.top, bottom = (float)(frame.top + frame.height);
+
+    quad[0].texCoords = sf::Vector2f(left, top);
+    quad[1].texCoords = sf::Vector2f(left, bottom);
+    quad[2].texCoords = sf::Vector2f(right, top);
+    quad[3].texCoords = sf::Vector2f(right, top);
+    quad[4].texCoords = sf::Vector2f(left, bottom);
+    quad[5].texCoords = sf::Vector2f(right, bottom);
+}
+
+void PropLayer::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+    bool useBuffers = sf::VertexBuffer::isAvailable();
+    for (Group& g : mGroups)
+    {
+        std::size_t count = g.vertices.getVertexCount();
+        if (count == 0)
+            continue;
+
+        if (useBuffers && !g.uploaded)
+        {
+            if (g.buffer.getVertexCount() != count)
+                g.buffer.create(count);
+            g.uploaded = g.buffer.update(&g.vertices[0]);
+        }
+
+        states.texture = g.texture;
+        if (g.uploaded)
+            target.draw(g.buffer, states);
+        else // No vertex buffer support, submit from client memory
+            target.draw(g.vertices, states);
+    }
+}
+
+std::size_t PropLayer::getPropCount() const
+{
+    std::size_t count = 0;
+    for (const Group& g : mGroups)
+        count += g.vertices.getVertexCount() / 6;
+    return count;
+}
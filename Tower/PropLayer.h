@@ -0,0 +1,46 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "FrameAnimator.h"
+#include "TextureAtlas.h"
+
+// Ambient map props grouped by animation clip. Every prop of a group shows
+// the same frame, so a group has one animation clock and one vertex array:
+// a frame change rewrites texture coordinates only, and drawing costs one
+// call per group however many props it holds. Vertices live in a Dynamic
+// GPU buffer, re-sent only when the frame changes.
+class PropLayer
+{
+public:
+    struct Clip
+    {
+        TextureRegion sheet; // Frames laid out left to right from the region's corner
+        int frameWidth, frameHeight;
+        int frameCount;
+        float frameTime;
+    };
+
+    int addClip(const Clip& clip); // Returns the group index for addProp
+    void addProp(int group, sf::Vector2f position); // Top-left corner of the prop
+    void clear();
+
+    void update(float dt);
+    void draw(sf::RenderTarget& target, sf::RenderStates states = sf::RenderStates::Default) const;
+
+    std::size_t getPropCount() const;
+
+private:
+    struct Group
+    {
+        const sf::Texture* texture;
+        FrameAnimator clock;
+        sf::IntRect frame;          // Frame the texture coordinates currently show
+        sf::VertexArray vertices;   // Six per prop
+        sf::VertexBuffer buffer;
+        bool uploaded;              // buffer matches vertices
+    };
+
+    static void writeTexCoords(sf::Vertex* quad, const sf::IntRect& frame);
+
+    mutable std::vector<Group> mGroups; // draw() uploads changed groups
+};
@@ -0,0 +1,182 @@
+#include "RenderQueue.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace
+{
+    const int INDEX_BITS = 20;
+    const int BLEND_SHIFT = INDEX_BITS;
+    const int TEXTURE_SHIFT = BLEND_SHIFT + 4;
+    const int DEPTH_SHIFT = TEXTURE_SHIFT + 12;
+    const int LAYER_SHIFT = DEPTH_SHIFT + 20;
+
+    const std::uint64_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+    const int MAX_DEPTH = (1 << 20) - 1;
+    const std::size_t MAX_TEXTURES = 1 << 12;
+    const std::size_t MAX_BLENDS = 1 << 4;
+}
+
+RenderQueue::RenderQueue()
+    : mBuffer(sf::Triangles, sf::VertexBuffer::Stream)
+{
+}
+
+void RenderQueue::clear()
+{
+    mKeys.clear();
+    mVertices.clear();
+    mTextures.clear();
+    mBlends.clear();
+    mBatches.clear();
+}
+
+void RenderQueue::add(const sf::Sprite& sprite, std::uint8_t layer, float depth, const sf::BlendMode& blend)
+{
+    std::size_t index = push(sprite.getTexture(), layer, depth, blend);
+    writeQuad(sprite, &mVertices[index * 6]);
+}
+
+void RenderQueue::add(const sf::Vertex* quad, const sf::Texture* texture, std::uint8_t layer, float depth, const sf::BlendMode& blend)
+{
+    std::size_t index = push(texture, layer, depth, blend);
+    std::copy(quad, quad + 6, &mVertices[index * 6]);
+}
+
+std::size_t RenderQueue::push(const sf::Texture* texture, std::uint8_t layer, float depth, const sf::BlendMode& blend)
+{
+    std::size_t index = mKeys.size();
+    assert(index <= INDEX_MASK);
+
+    // Screen y to an unsigned 20-bit depth, centered so slightly negative y still sorts
+    int d = (int)std::floor(depth) + (1 << 19);
+    d = std::max(0, std::min(MAX_DEPTH, d));
+
+    std::uint64_t key = (std::uint64_t)layer << LAYER_SHIFT
+        | (std::uint64_t)d << DEPTH_SHIFT
+        | (std::uint64_t)textureId(texture) << TEXTURE_SHIFT
+        | (std::uint64_t)blendId(blend) << BLEND_SHIFT
+        | index;
+    mKeys.push_back(key);
+
+    mVertices.resize(mVertices.size() + 6);
+    return index;
+}
+
+void RenderQueue::writeQuad(const sf::Sprite& sprite, sf::Vertex* out)
+{
+    // Same quad sf::Sprite builds: a negative rect size flips the texture
+    sf::FloatRect rect(sprite.getTextureRect());
+    float width = std::abs(rect.width);
+    float height = std::abs(rect.height);
+    float left = rect.left, right = rect.left + rect.width;
+    float top = rect.top, bottom = rect.top + rect.height;
+
+    const sf::Transform& transform = sprite.getTransform();
+    sf::Color color = sprite.getColor();
+
+    sf::Vertex topLeft(transform.transformPoint(0.f, 0.f), color, sf::Vector2f(left, top));
+    sf::Vertex bottomLeft(transform.transformPoint(0.f, height), color, sf::Vector2f(left, bottom));
+    sf::Vertex topRight(transform.transformPoint(width, 0.f), color, sf::Vector2f(right, top));
+    sf::Vertex bottomRight(transform.transformPoint(width, height), color, sf::Vector2f(right, bottom));
+
+    out[0] = topLeft;
+    out[1] = bottomLeft;
+    out[2] = topRight;
+    out[3] = topRight;
+    out[4] = bottomLeft;
+    out[5] = bottomRight;
+}
+
+std::size_t RenderQueue::textureId(const sf::Texture* texture)
+{
+    // A frame only touches a few textures, a linear search beats a map
+    for (std::size_t i = 0; i < mTextures.size(); ++i)
+        if (mTextures[i] == texture)
+            return i;
+
+    assert(mTextures.size() < MAX_TEXTURES);
+    mTextures.push_back(texture);
+    return mTextures.size() - 1;
+}
+
+std::size_t RenderQueue::blendId(const sf::BlendMode& blend)
+{
+    for (std::size_t i = 0; i < mBlends.size(); ++i)
+        if (mBlends[i] == blend)
+            return i;
+
+    assert(mBlends.size() < MAX_BLENDS);
+    mBlends.push_back(blend);
+    return mBlends.size() - 1;
+}
+
+void RenderQueue::sortKeys()
+{
+    // LSD radix sort, one byte per pass. It is stable and the index sits in the
+    // low bits in submission order, so only the bytes above it need sorting.
+    std::size_t n = mKeys.size();
+    mScratch.resize(n);
+
+    for (int shift = 16; shift < 64; shift += 8)
+    {
+        std::size_t count[257] = {};
+        for (std::uint64_t key : mKeys)
+            ++count[((key >> shift) & 0xFF) + 1];
+
+        // Every key shares this byte, the pass would change nothing
+        if (count[((mKeys[0] >> shift) & 0xFF) + 1] == n)
+            continue;
+
+        for (int b = 0; b < 256; ++b)
+            count[b + 1] += count[b];
+        for (std::uint64_t key : mKeys)
+            mScratch[count[(key >> shift) & 0xFF]++] = key;
+        mKeys.swap(mScratch);
+    }
+}
+
+void RenderQueue::draw(sf::RenderTarget& target, sf::RenderStates states)
+{
+    if (mKeys.empty())
+        return;
+
+    sortKeys();
+
+    // Lay the vertices out in draw order and merge compatible neighbours
+    mSorted.resize(mVertices.size());
+    mBatches.clear();
+    for (std::size_t i = 0; i < mKeys.size(); ++i)
+    {
+        std::uint64_t key = mKeys[i];
+        std::size_t index = (std::size_t)(key & INDEX_MASK);
+        const sf::Texture* texture = mTextures[(key >> TEXTURE_SHIFT) & (MAX_TEXTURES - 1)];
+        std::size_t blend = (std::size_t)((key >> BLEND_SHIFT) & (MAX_BLENDS - 1));
+
+        std::copy(&mVertices[index * 6], &mVertices[index * 6] + 6, &mSorted[i * 6]);
+
+        if (!mBatches.empty() && mBatches.back().texture == texture && mBatches.back().blend == blend)
+            mBatches.back().count += 6;
+        else
+            mBatches.push_back({ i * 6, 6, texture, blend });
+    }
+
+    bool buffered = false;
+    if (sf::VertexBuffer::isAvailable())
+    {
+        // Grow by doubling so a busy frame does not reallocate the buffer every time
+        if (mBuffer.getVertexCount() < mSorted.size())
+            mBuffer.create(std::max<std::size_t>(mSorted.size(), mBuffer.getVertexCount() * 2));
+        buffered = mBuffer.update(mSorted.data(), mSorted.size(), 0);
+    }
+
+    for (const Batch& batch : mBatches)
+    {
+        states.texture = batch.texture;
+        states.blendMode = mBlends[batch.blend];
+        if (buffered)
+            target.draw(mBuffer, batch.first, batch.count, states);
+        else // No vertex buffer support, submit from client memory
+            target.draw(&mSorted[batch.first], batch.count, sf::Triangles, states);
+    }
+}
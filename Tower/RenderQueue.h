@@ -0,0 +1,50 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+// Sorted draw list for one frame. Every command carries a 64-bit key
+//   layer:8 | depth:20 | texture:12 | blend:4 | submission index:20
+// and is radix sorted by it, so layers paint in order, each layer back to
+// front by depth (screen y), and equal depths group by texture. Runs of
+// commands that share texture and blend mode are drawn with one call from
+// a single streamed vertex buffer.
+class RenderQueue
+{
+public:
+    RenderQueue();
+
+    void clear();
+    void add(const sf::Sprite& sprite, std::uint8_t layer, float depth, const sf::BlendMode& blend = sf::BlendAlpha);
+    // A prebuilt quad, the six vertices in the order sf::Sprite draws them
+    void add(const sf::Vertex* quad, const sf::Texture* texture, std::uint8_t layer, float depth, const sf::BlendMode& blend = sf::BlendAlpha);
+    void draw(sf::RenderTarget& target, sf::RenderStates states = sf::RenderStates::Default);
+
+    std::size_t getDrawCalls() const { return mBatches.size(); }
+
+private:
+    struct Batch
+    {
+        std::size_t first, count; // Vertex range in mSorted
+        const sf::Texture* texture;
+        std::size_t blend;
+    };
+
+    // The two triangles sf::Sprite draws, transformed, into out[0..5]
+    static void writeQuad(const sf::Sprite& sprite, sf::Vertex* out);
+
+    // Keys a command and makes room for its vertices, returns its index
+    std::size_t push(const sf::Texture* texture, std::uint8_t layer, float depth, const sf::BlendMode& blend);
+
+    std::size_t textureId(const sf::Texture* texture);
+    std::size_t blendId(const sf::BlendMode& blend);
+    void sortKeys();
+
+    std::vector<std::uint64_t> mKeys, mScratch;
+    std::vector<sf::Vertex> mVertices; // Six per command, in submission order
+    std::vector<sf::Vertex> mSorted;   // Same vertices in draw order
+    std::vector<const sf::Texture*> mTextures; // Key ids of this frame
+    std::vector<sf::BlendMode> mBlends;
+    std::vector<Batch> mBatches;
+    sf::VertexBuffer mBuffer;
+};
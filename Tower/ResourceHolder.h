@@ -5,21 +5,215 @@
 #include <memory>
 #include <stdexcept>
 #include <cassert>
+#include <algorithm>
+#include <limits>
 
+#include "TextureAtlas.h"
+#include "ResourceLoader.h"
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/Audio/Music.hpp>
+
+// Bytes a resident resource costs, as counted against a holder's budget
+template <typename Resource>
+std::size_t resourceSize(const Resource&) { return 0; }
+inline std::size_t resourceSize(const sf::Texture& texture) { return (std::size_t)texture.getSize().x * texture.getSize().y * 4; }
+inline std::size_t resourceSize(const sf::SoundBuffer& buffer) { return (std::size_t)buffer.getSampleCount() * sizeof(sf::Int16); }
+
+template <typename Resource>
+bool loadResource(Resource& resource, const std::string& filename) { return resource.loadFromFile(filename); }
+inline bool loadResource(sf::Music& music, const std::string& filename) { return music.openFromFile(filename); }
+
+// Owns resources by identifier. load() and open() keep a resource for the
+// holder's lifetime. declare() only records the file: the resource is loaded
+// on first acquire(), and once no Handle refers to it, it stays cached until
+// the unreferenced declared resources outgrow the memory budget, least
+// recently used first. get() refuses declared resources, a bare reference
+// could be evicted under its user, so acquire() is the only way to them.
 template <typename Resource, typename Identifier>
 class ResourceHolder
 {
 public:
+    class Handle
+    {
+    public:
+        Handle();
+        Handle(Handle&& other);
+        Handle& operator=(Handle&& other);
+        ~Handle();
+
+        Resource& operator*() const { return *mResource; }
+        Resource* operator->() const { return mResource; }
+        Resource* get() const { return mResource; }
+        void reset();
+
+    private:
+        friend class ResourceHolder;
+        Handle(ResourceHolder& holder, Identifier id, Resource& resource);
+
+        ResourceHolder* mHolder;
+        Identifier mId;
+        Resource* mResource;
+    };
+
+    ResourceHolder();
+
     void load(Identifier id, const std::string& filename);
+    void load(ResourceLoader& loader, Identifier id, const std::string& filename); // Available once the loader completes it
     void open(Identifier id, const std::string& filename);
+    void declare(Identifier id, const std::string& filename);
     Resource& get(Identifier id);
     const Resource& get(Identifier id) const;
+    Handle acquire(Identifier id); // Loads a declared resource if needed and keeps it resident
+
+    void setMemoryBudget(std::size_t bytes); // For declared resources nothing refers to
+    void trim(); // Evicts until those fit the budget
+    std::size_t getCachedBytes() const;
+
+protected:
+    void insert(Identifier id, std::unique_ptr<Resource> resource);
+    bool hasRoomFor(std::size_t bytes) const; // Could a declared resource this size stay cached
+    void cache(Identifier id, std::unique_ptr<Resource> resource); // Installs a declared resource, unreferenced
+    bool isResident(Identifier id) const { return mResourceMap.count(id) != 0; }
+    bool isDeclared(Identifier id) const { return mDeclared.count(id) != 0; }
 
 private:
+    struct Declared
+    {
+        std::string filename;
+        std::size_t references = 0;
+        std::size_t bytes = 0;
+        unsigned long long lastUse = 0;
+    };
+
+    Resource& loadDeclared(Identifier id); // Resident on return, the caller holds a reference
+    void release(Identifier id);
+    void touch(Declared& declared) { declared.lastUse = ++mUseCount; }
+
     std::map<Identifier, std::unique_ptr<Resource>> mResourceMap;
+    std::map<Identifier, Declared> mDeclared;
+    std::size_t mBudget;
+    unsigned long long mUseCount;
+};
+
+// Texture holder that can also pack textures into atlas pages. Packed
+// textures are only reachable through getRegion(), which also answers for
+// standalone ones, so sprites take a region and never care where it lives.
+// The SheetFormat overloads resample a sheet to the scale it is drawn at;
+// the region's scale then tells sprites how to map authored frame sizes.
+template <typename Identifier>
+class AtlasHolder : public ResourceHolder<sf::Texture, Identifier>
+{
+public:
+    using ResourceHolder<sf::Texture, Identifier>::load;
+    void load(Identifier id, const std::string& filename, const SheetFormat& format);
+
+    void pack(Identifier id, const std::string& filename, sf::Vector2u reserve = sf::Vector2u());
+    void pack(Identifier id, const std::string& filename, const SheetFormat& format);
+
+    // Deferred forms: a loader worker reads, decodes and resamples the image,
+    // the loader's thread then uploads it or queues it for the atlas, in order
+    void load(ResourceLoader& loader, Identifier id, const std::string& filename);
+    void load(ResourceLoader& loader, Identifier id, const std::string& filename, const SheetFormat& format);
+    void pack(ResourceLoader& loader, Identifier id, const std::string& filename, sf::Vector2u reserve = sf::Vector2u());
+    void pack(ResourceLoader& loader, Identifier id, const std::string& filename, const SheetFormat& format);
+
+    // Declares a standalone texture and has a worker decode it ahead of time;
+    // it is kept only if it fits the budget, otherwise first use loads it
+    using ResourceHolder<sf::Texture, Identifier>::declare;
+    void declare(ResourceLoader& loader, Identifier id, const std::string& filename);
+
+    void buildAtlas(); // Uploads every texture queued by pack()
+    TextureRegion getRegion(Identifier id) const;
+
+    std::size_t getAtlasPageCount() const { return mAtlas.getPageCount(); }
+
+private:
+    struct Decoded
+    {
+        sf::Image image;
+        sf::Vector2f scale = sf::Vector2f(1.f, 1.f);
+    };
+
+    static void decode(Decoded& decoded, const std::string& filename, const SheetFormat& format);
+    void upload(Identifier id, const Decoded& decoded, const std::string& filename);
+
+    TextureAtlas mAtlas;
+    std::map<Identifier, sf::Vector2f> mScales; // Downscaled standalone textures
+};
+
+// Font holder whose fonts are shared by reference, so each sf::Font keeps the
+// one glyph cache every state draws from. prewarm() rasterizes the printable
+// ASCII range ahead of time so the first frame of a state renders no glyphs.
+template <typename Identifier>
+class FontCacheHolder : public ResourceHolder<sf::Font, Identifier>
+{
+public:
+    void prewarm(Identifier id, unsigned int characterSize, bool bold = false, float outlineThickness = 0.f);
 };
 
 // Template implementations
+template <typename Resource, typename Identifier>
+ResourceHolder<Resource, Identifier>::Handle::Handle()
+    : mHolder(nullptr)
+    , mId()
+    , mResource(nullptr)
+{
+}
+
+template <typename Resource, typename Identifier>
+ResourceHolder<Resource, Identifier>::Handle::Handle(ResourceHolder& holder, Identifier id, Resource& resource)
+    : mHolder(&holder)
+    , mId(id)
+    , mResource(&resource)
+{
+}
+
+template <typename Resource, typename Identifier>
+ResourceHolder<Resource, Identifier>::Handle::Handle(Handle&& other)
+    : mHolder(other.mHolder)
+    , mId(other.mId)
+    , mResource(other.mResource)
+{
+    other.mHolder = nullptr;
+    other.mResource = nullptr;
+}
+
+template <typename Resource, typename Identifier>
+typename ResourceHolder<Resource, Identifier>::Handle& ResourceHolder<Resource, Identifier>::Handle::operator=(Handle&& other)
+{
+    if (this != &other)
+    {
+        reset();
+        std::swap(mHolder, other.mHolder);
+        std::swap(mId, other.mId);
+        std::swap(mResource, other.mResource);
+    }
+    return *this;
+}
+
+template <typename Resource, typename Identifier>
+ResourceHolder<Resource, Identifier>::Handle::~Handle()
+{
+    reset();
+}
+
+template <typename Resource, typename Identifier>
+void ResourceHolder<Resource, Identifier>::Handle::reset()
+{
+    if (mHolder)
+        mHolder->release(mId);
+    mHolder = nullptr;
+    mResource = nullptr;
+}
+
+template <typename Resource, typename Identifier>
+ResourceHolder<Resource, Identifier>::ResourceHolder()
+    : mBudget(std::numeric_limits<std::size_t>::max())
+    , mUseCount(0)
+{
+}
+
 template <typename Resource, typename Identifier>
 void ResourceHolder<Resource, Identifier>::load(Identifier id, const std::string& filename)
 {
@@ -27,11 +221,29 @@ void ResourceHolder<Resource, Identifier>::load(Identifier id, const std::string
     if (!resource->loadFromFile(filename))
         throw std::runtime_error("ResourceHolder::load - Failed to load " + filename);
 
+    insert(id, std::move(resource));
+}
+
+template <typename Resource, typename Identifier>
+void ResourceHolder<Resource, Identifier>::load(ResourceLoader& loader, Identifier id, const std::string& filename)
+{
+    // Shared by both steps, std::function needs copyable captures
+    auto resource = std::make_shared<std::unique_ptr<Resource>>(new Resource());
+    loader.enqueue(
+        [resource, filename] {
+            if (!(*resource)->loadFromFile(filename))
+                throw std::runtime_error("ResourceHolder::load - Failed to load " + filename);
+        },
+        [this, resource, id] { insert(id, std::move(*resource)); });
+}
+
+template <typename Resource, typename Identifier>
+void ResourceHolder<Resource, Identifier>::insert(Identifier id, std::unique_ptr<Resource> resource)
+{
     auto inserted = mResourceMap.insert(std::make_pair(id, std::move(resource)));
     assert(inserted.second);
 }
 
-// Template implementations
 template <typename Resource, typename Identifier>
 void ResourceHolder<Resource, Identifier>::open(Identifier id, const std::string& filename)
 {
@@ -44,20 +256,279 @@ void ResourceHolder<Resource, Identifier>::open(Identifier id, const std::string
         throw std::runtime_error("ResourceHolder::open - Duplicate resource ID");
 }
 
+template <typename Resource, typename Identifier>
+void ResourceHolder<Resource, Identifier>::declare(Identifier id, const std::string& filename)
+{
+    auto inserted = mDeclared.insert(std::make_pair(id, Declared()));
+    if (!inserted.second || isResident(id))
+        throw std::runtime_error("ResourceHolder::declare - Duplicate resource ID");
+
+    inserted.first->second.filename = filename;
+}
+
 template <typename Resource, typename Identifier>
 Resource& ResourceHolder<Resource, Identifier>::get(Identifier id)
 {
+    if (isDeclared(id))
+        throw std::runtime_error("ResourceHolder::get - Declared resource, use acquire()");
+
     auto found = mResourceMap.find(id);
     assert(found != mResourceMap.end());
 
     return *found->second;
 }
 
+template <typename Resource, typename Identifier>
+typename ResourceHolder<Resource, Identifier>::Handle ResourceHolder<Resource, Identifier>::acquire(Identifier id)
+{
+    if (!isDeclared(id))
+        throw std::runtime_error("ResourceHolder::acquire - Resource not declared");
+
+    ++mDeclared[id].references; // Before loading, so the trim() that follows cannot evict it
+    try
+    {
+        return Handle(*this, id, loadDeclared(id));
+    }
+    catch (...)
+    {
+        --mDeclared[id].references;
+        throw;
+    }
+}
+
+template <typename Resource, typename Identifier>
+Resource& ResourceHolder<Resource, Identifier>::loadDeclared(Identifier id)
+{
+    Declared& declared = mDeclared[id];
+    touch(declared);
+
+    auto found = mResourceMap.find(id);
+    if (found != mResourceMap.end())
+        return *found->second;
+
+    // Not resident yet, or evicted since: load it from the declared file
+    std::unique_ptr<Resource> resource(new Resource());
+    if (!loadResource(*resource, declared.filename))
+        throw std::runtime_error("ResourceHolder::acquire - Failed to load " + declared.filename);
+
+    declared.bytes = resourceSize(*resource);
+    Resource& loaded = *resource;
+    insert(id, std::move(resource));
+    trim(); // Holds the cache to the budget, the caller's reference keeps this one out of it
+    return loaded;
+}
+
+template <typename Resource, typename Identifier>
+void ResourceHolder<Resource, Identifier>::release(Identifier id)
+{
+    Declared& declared = mDeclared[id];
+    assert(declared.references > 0);
+
+    --declared.references;
+    touch(declared);
+    trim();
+}
+
+template <typename Resource, typename Identifier>
+void ResourceHolder<Resource, Identifier>::setMemoryBudget(std::size_t bytes)
+{
+    mBudget = bytes;
+    trim();
+}
+
+template <typename Resource, typename Identifier>
+void ResourceHolder<Resource, Identifier>::trim()
+{
+    std::size_t cached = getCachedBytes();
+    while (cached > mBudget)
+    {
+        // Only a few resources are ever declared, a scan is enough
+        auto victim = mDeclared.end();
+        for (auto it = mDeclared.begin(); it != mDeclared.end(); ++it)
+        {
+            if (it->second.references == 0 && isResident(it->first)
+                && (victim == mDeclared.end() || it->second.lastUse < victim->second.lastUse))
+                victim = it;
+        }
+        assert(victim != mDeclared.end());
+
+        mResourceMap.erase(victim->first);
+        cached -= victim->second.bytes;
+    }
+}
+
+template <typename Resource, typename Identifier>
+std::size_t ResourceHolder<Resource, Identifier>::getCachedBytes() const
+{
+    std::size_t bytes = 0;
+    for (const auto& declared : mDeclared)
+        if (declared.second.references == 0 && isResident(declared.first))
+            bytes += declared.second.bytes;
+    return bytes;
+}
+
+template <typename Resource, typename Identifier>
+bool ResourceHolder<Resource, Identifier>::hasRoomFor(std::size_t bytes) const
+{
+    return bytes <= mBudget && getCachedBytes() <= mBudget - bytes;
+}
+
+template <typename Resource, typename Identifier>
+void ResourceHolder<Resource, Identifier>::cache(Identifier id, std::unique_ptr<Resource> resource)
+{
+    Declared& declared = mDeclared[id];
+    declared.bytes = resourceSize(*resource);
+    touch(declared);
+    insert(id, std::move(resource));
+    trim();
+}
+
 template <typename Resource, typename Identifier>
 const Resource& ResourceHolder<Resource, Identifier>::get(Identifier id) const
 {
     auto found = mResourceMap.find(id);
+    if (found == mResourceMap.end() && isDeclared(id)) // Cannot load from a const holder
+        throw std::runtime_error("ResourceHolder::get - Declared resource not loaded, use acquire()");
     assert(found != mResourceMap.end());
 
     return *found->second;
 }
+
+template <typename Identifier>
+void AtlasHolder<Identifier>::load(Identifier id, const std::string& filename, const SheetFormat& format)
+{
+    Decoded decoded;
+    decode(decoded, filename, format);
+    upload(id, decoded, filename);
+}
+
+template <typename Identifier>
+void AtlasHolder<Identifier>::decode(Decoded& decoded, const std::string& filename, const SheetFormat& format)
+{
+    if (!decoded.image.loadFromFile(filename))
+        throw std::runtime_error("AtlasHolder::load - Failed to load " + filename);
+    decoded.scale = downscaleSheet(decoded.image, format);
+}
+
+template <typename Identifier>
+void AtlasHolder<Identifier>::upload(Identifier id, const Decoded& decoded, const std::string& filename)
+{
+    std::unique_ptr<sf::Texture> texture(new sf::Texture());
+    if (!texture->loadFromImage(decoded.image))
+        throw std::runtime_error("AtlasHolder::load - Failed to create texture for " + filename);
+
+    this->insert(id, std::move(texture));
+    if (decoded.scale != sf::Vector2f(1.f, 1.f))
+        mScales[id] = decoded.scale;
+}
+
+template <typename Identifier>
+void AtlasHolder<Identifier>::load(ResourceLoader& loader, Identifier id, const std::string& filename)
+{
+    load(loader, id, filename, SheetFormat());
+}
+
+template <typename Identifier>
+void AtlasHolder<Identifier>::load(ResourceLoader& loader, Identifier id, const std::string& filename, const SheetFormat& format)
+{
+    auto decoded = std::make_shared<Decoded>();
+    loader.enqueue(
+        [decoded, filename, format] { decode(*decoded, filename, format); },
+        [this, decoded, id, filename] { upload(id, *decoded, filename); });
+}
+
+template <typename Identifier>
+void AtlasHolder<Identifier>::pack(ResourceLoader& loader, Identifier id, const std::string& filename, sf::Vector2u reserve)
+{
+    auto decoded = std::make_shared<Decoded>();
+    loader.enqueue(
+        [decoded, filename] {
+            if (!decoded->image.loadFromFile(filename))
+                throw std::runtime_error("AtlasHolder::pack - Failed to load " + filename);
+        },
+        [this, decoded, id, reserve] { mAtlas.add(static_cast<int>(id), std::move(decoded->image), reserve); });
+}
+
+template <typename Identifier>
+void AtlasHolder<Identifier>::pack(ResourceLoader& loader, Identifier id, const std::string& filename, const SheetFormat& format)
+{
+    auto decoded = std::make_shared<Decoded>();
+    loader.enqueue(
+        [decoded, filename, format] { decode(*decoded, filename, format); },
+        [this, decoded, id, format] {
+            mAtlas.add(static_cast<int>(id), std::move(decoded->image), format.getReserve(decoded->scale), decoded->scale);
+        });
+}
+
+template <typename Identifier>
+void AtlasHolder<Identifier>::pack(Identifier id, const std::string& filename, sf::Vector2u reserve)
+{
+    mAtlas.add(static_cast<int>(id), filename, reserve);
+}
+
+template <typename Identifier>
+void AtlasHolder<Identifier>::pack(Identifier id, const std::string& filename, const SheetFormat& format)
+{
+    mAtlas.add(static_cast<int>(id), filename, format);
+}
+
+template <typename Identifier>
+void AtlasHolder<Identifier>::declare(ResourceLoader& loader, Identifier id, const std::string& filename)
+{
+    this->declare(id, filename);
+
+    auto image = std::make_shared<sf::Image>();
+    loader.enqueue(
+        [image, filename] {
+            if (!image->loadFromFile(filename))
+                throw std::runtime_error("AtlasHolder::declare - Failed to load " + filename);
+        },
+        [this, image, id, filename] {
+            // Already pulled in by an acquire(), or no room: leave it to first use
+            sf::Vector2u size = image->getSize();
+            if (this->isResident(id) || !this->hasRoomFor((std::size_t)size.x * size.y * 4))
+                return;
+
+            std::unique_ptr<sf::Texture> texture(new sf::Texture());
+            if (!texture->loadFromImage(*image))
+                throw std::runtime_error("AtlasHolder::declare - Failed to create texture for " + filename);
+            this->cache(id, std::move(texture));
+        });
+}
+
+template <typename Identifier>
+void AtlasHolder<Identifier>::buildAtlas()
+{
+    mAtlas.pack(std::min(4096u, sf::Texture::getMaximumSize()));
+}
+
+template <typename Identifier>
+TextureRegion AtlasHolder<Identifier>::getRegion(Identifier id) const
+{
+    if (const TextureRegion* packed = mAtlas.find(static_cast<int>(id)))
+        return *packed;
+
+    // A region holds no reference, the texture could be evicted under it
+    if (this->isDeclared(id))
+        throw std::runtime_error("AtlasHolder::getRegion - Declared texture, use acquire()");
+
+    TextureRegion region;
+    region.texture = &this->get(id);
+    region.rect = sf::IntRect(sf::Vector2i(), sf::Vector2i(region.texture->getSize()));
+    auto scale = mScales.find(id);
+    if (scale != mScales.end())
+        region.scale = scale->second;
+    return region;
+}
+
+template <typename Identifier>
+void FontCacheHolder<Identifier>::prewarm(Identifier id, unsigned int characterSize, bool bold, float outlineThickness)
+{
+    const sf::Font& font = this->get(id);
+    for (sf::Uint32 c = 0x20; c < 0x7F; ++c)
+    {
+        font.getGlyph(c, characterSize, bold);
+        if (outlineThickness != 0.f) // Outlined text draws the outline and the fill glyph
+            font.getGlyph(c, characterSize, bold, outlineThickness);
+    }
+}
@@ -181,6 +181,11 @@ namespace GameConstants
     // Passive income (per wave or per time interval)
     const int PASSIVE_INCOME = 25;
     const float INCOME_INTERVAL = 10.0f; // Seconds between passive income
+
+    // Scales sprites are drawn at; their sheets are resampled to them on load
+    const float TOWER_SCALE = 0.4f;
+    const float FIRE_BULLET_SCALE = 0.1f;
+    const float SMALL_ENEMY_SCALE = 0.5f; // Fast scout and heavy walker
 }
 
 namespace SoundBuffers
@@ -210,6 +215,18 @@ namespace SoundBuffers
     };
 }
 
+// Load priority groups, in the order the states first need them
+namespace Assets
+{
+    enum Tier
+    {
+        Menu,
+        MapSelection,
+        Game,
+        TierCount
+    };
+}
+
 namespace Musics
 {
     enum ID
@@ -220,7 +237,7 @@ namespace Musics
 }
 
 // Type aliases for easy access
-using TextureHolder = ResourceHolder<sf::Texture, Textures::ID>;
-using FontHolder = ResourceHolder<sf::Font, Fonts::ID>;
+using TextureHolder = AtlasHolder<Textures::ID>;
+using FontHolder = FontCacheHolder<Fonts::ID>;
 using SoundBufferHolder = ResourceHolder<sf::SoundBuffer, SoundBuffers::ID>;
 using MusicHolder = ResourceHolder<sf::Music, Musics::ID>;
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include "ResourceLoader.h"
+#include <SFML/System/Clock.hpp>
+#include <algorithm>
+#include <cassert>
+
+ResourceLoader::ResourceLoader(unsigned threadCount)
+    : mCompleted(0)
+    , mNext(0)
+    , mStopping(false)
+{
+    // The thread that calls require() decodes too, so it counts as one of the
+    // cores. Keep one worker even on a single core: update() never decodes
+    if (threadCount == 0)
+        threadCount = std::max(2u, std::thread::hardware_concurrency()) - 1;
+
+    for (unsigned i = 0; i < threadCount; ++i)
+        mWorkers.emplace_back(&ResourceLoader::workerLoop, this);
+}
+
+ResourceLoader::~ResourceLoader()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mWork.notify_all();
+
+    for (std::thread& worker : mWorkers)
+        worker.join();
+}
+
+void ResourceLoader::enqueue(std::function<void()> decode, std::function<void()> complete)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mJobs.push_back({ std::move(decode), std::move(complete), nullptr, false });
+    }
+    mWork.notify_one();
+}
+
+void ResourceLoader::endTier(std::size_t tier)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mTierEnds.size() <= tier)
+        mTierEnds.resize(tier + 1, 0);
+    mTierEnds[tier] = mCompleted + mJobs.size();
+}
+
+std::size_t ResourceLoader::update(sf::Time budget)
+{
+    sf::Clock clock;
+    std::size_t count = 0;
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (!mJobs.empty() && mJobs.front().decoded && clock.getElapsedTime() < budget)
+    {
+        completeFront(lock);
+        ++count;
+    }
+    return count;
+}
+
+void ResourceLoader::require(std::size_t tier)
+{
+    completeUpTo(getTierEnd(tier));
+}
+
+void ResourceLoader::finish()
+{
+    std::size_t end;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        end = mCompleted + mJobs.size();
+    }
+    completeUpTo(end);
+}
+
+bool ResourceLoader::isReady(std::size_t tier) const
+{
+    std::size_t end = getTierEnd(tier);
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mCompleted >= end;
+}
+
+float ResourceLoader::getProgress(std::size_t tier) const
+{
+    std::size_t end = getTierEnd(tier);
+    std::lock_guard<std::mutex> lock(mMutex);
+    return end == 0 ? 1.f : std::min(1.f, (float)mCompleted / end);
+}
+
+std::size_t ResourceLoader::getTierEnd(std::size_t tier) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    assert(tier < mTierEnds.size());
+    return mTierEnds[tier];
+}
+
+void ResourceLoader::completeUpTo(std::size_t end)
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (mCompleted < end)
+    {
+        if (mJobs.front().decoded)
+            completeFront(lock);
+        else if (mNext < end) // Help with this tier only, later ones can wait
+            decodeNext(lock);
+        else
+            mDecoded.wait(lock);
+    }
+}
+
+void ResourceLoader::completeFront(std::unique_lock<std::mutex>& lock)
+{
+    // Decoded, so no worker holds it any more
+    Job job = std::move(mJobs.front());
+    mJobs.pop_front();
+    ++mCompleted;
+    lock.unlock();
+
+    if (job.error)
+        std::rethrow_exception(job.error);
+    job.complete();
+
+    lock.lock();
+}
+
+void ResourceLoader::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    for (;;)
+    {
+        mWork.wait(lock, [this] { return mStopping || mNext < mCompleted + mJobs.size(); });
+        if (mStopping)
+            return;
+
+        decodeNext(lock);
+    }
+}
+
+void ResourceLoader::decodeNext(std::unique_lock<std::mutex>& lock)
+{
+    Job& job = mJobs[mNext++ - mCompleted];
+    lock.unlock();
+
+    try
+    {
+        job.decode();
+    }
+    catch (...)
+    {
+        job.error = std::current_exception();
+    }
+
+    lock.lock();
+    job.decoded = true;
+    mDecoded.notify_all();
+}
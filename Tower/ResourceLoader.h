@@ -0,0 +1,67 @@
+#pragma once
+#include <SFML/System/Time.hpp>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Runs the CPU side of resource loading (file reads, image and sound
+// decoding) on a pool of worker threads. Each request pairs a decode step,
+// run on any thread, with a complete step that always runs on the thread
+// driving the loader, in request order, which is where GL uploads have to
+// happen. Requests are decoded in the order they were queued, so queue
+// order is priority. endTier() closes a priority tier; require() blocks on
+// one tier only, and update() streams whatever is ready between frames.
+class ResourceLoader
+{
+public:
+    explicit ResourceLoader(unsigned threadCount = 0); // 0 uses every core, the calling thread included; at least one worker
+    ~ResourceLoader();
+
+    ResourceLoader(const ResourceLoader&) = delete;
+    ResourceLoader& operator=(const ResourceLoader&) = delete;
+
+    void enqueue(std::function<void()> decode, std::function<void()> complete);
+    void endTier(std::size_t tier); // Everything queued so far belongs to tier or a lower one
+
+    // Completes requests whose decode is done, in order, until budget runs
+    // out; never waits. Returns how many were completed.
+    std::size_t update(sf::Time budget);
+
+    // Help decode and wait until every request up to the end of tier, or
+    // every request at all, is completed. A decode that threw is rethrown at
+    // its place in the order.
+    void require(std::size_t tier);
+    void finish();
+
+    bool isReady(std::size_t tier) const;
+    float getProgress(std::size_t tier) const; // 0 to 1
+
+private:
+    struct Job
+    {
+        std::function<void()> decode;
+        std::function<void()> complete;
+        std::exception_ptr error;
+        bool decoded;
+    };
+
+    void workerLoop();
+    void decodeNext(std::unique_lock<std::mutex>& lock);
+    void completeFront(std::unique_lock<std::mutex>& lock);
+    void completeUpTo(std::size_t end);
+    std::size_t getTierEnd(std::size_t tier) const;
+
+    std::vector<std::thread> mWorkers;
+    std::deque<Job> mJobs; // Requests not completed yet, a deque so workers keep valid references
+    std::size_t mCompleted; // Requests ever completed, the index of mJobs.front()
+    std::size_t mNext;      // First request not yet taken by a thread
+    std::vector<std::size_t> mTierEnds;
+    bool mStopping;
+    mutable std::mutex mMutex;
+    std::condition_variable mWork;
+    std::condition_variable mDecoded;
+};
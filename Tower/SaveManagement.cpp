@@ -2,6 +2,7 @@
 #include "Utility.h"
 #include "Foreach.h"
 #include "ResourceHolder.h"
+#include "ResourceLoader.h"
 
 #include <filesystem>
 #include <sstream>
@@ -19,7 +20,9 @@ SaveManagement::SaveManagement(StateStack& stack, Context context)
 	, mOptions()
 	, mOptionIndex(0)
 {
-	Texture& texture = context.textures->get(Textures::loadBackground);
+	context.loader->require(Assets::MapSelection);
+
+	Texture& texture = acquireTexture(Textures::loadBackground);
 	Font& font = context.fonts->get(Fonts::RobotTraffic);
 
 	mBackgroundSprite.setTexture(texture);
@@ -232,7 +235,7 @@ bool SaveManagement::load(string pName)
 				getline(ss, temp, ' '); int x = stoi(temp);
 				getline(ss, temp, ' '); int y = stoi(temp);
 
-				t.setLocation(cpoint(x, y, 1));
+				t.setLocation(cpoint(x, y));
 				SaveManagement::playerResult[i].towers.push_back(t);
 			}
 		}
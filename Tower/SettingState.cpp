@@ -10,7 +10,7 @@ SettingState::SettingState(StateStack& stack, Context context)
 	: State(stack, context)
 {
 	// Set background
-	sf::Texture& texture = context.textures->get(Textures::optionsPanelInMenu);
+	sf::Texture& texture = acquireTexture(Textures::optionsPanelInMenu);
 	mBackgroundSprite.setTexture(texture);
 
 	// On / Off Button (for music background and sound effect)
@@ -2,7 +2,7 @@
 #include "StateStack.h"
 
 
-State::Context::Context(sf::RenderWindow& window, TextureHolder& textures, FontHolder& fonts, Player& player, int& stars, SoundBufferHolder& sfx, MusicHolder& music, bool& musicFlag, bool& sfxFlag, MusicState& musicState)
+State::Context::Context(sf::RenderWindow& window, TextureHolder& textures, FontHolder& fonts, Player& player, int& stars, SoundBufferHolder& sfx, MusicHolder& music, bool& musicFlag, bool& sfxFlag, MusicState& musicState, bool& restartFlag, ResourceLoader& loader)
 	: window(&window)
 	, textures(&textures)
 	, fonts(&fonts)
@@ -13,6 +13,8 @@ State::Context::Context(sf::RenderWindow& window, TextureHolder& textures, FontH
 	, isMusicOn(&musicFlag)
 	, isSoundOn(&sfxFlag)
 	, currentMusic(&musicState)
+	, restartLevel(&restartFlag)
+	, loader(&loader)
 {
 }
 
@@ -45,3 +47,9 @@ State::Context State::getContext() const
 {
 	return mContext;
 }
+
+sf::Texture& State::acquireTexture(Textures::ID id)
+{
+	mTextureHandles.push_back(mContext.textures->acquire(id));
+	return *mTextureHandles.back();
+}
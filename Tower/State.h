@@ -7,6 +7,7 @@
 #include <SFML/Window/Event.hpp>
 
 #include <memory>
+#include <vector>
 
 namespace sf
 {
@@ -15,6 +16,7 @@ namespace sf
 
 class StateStack;
 class Player;
+class ResourceLoader;
 
 class State
 {
@@ -27,7 +29,7 @@ public:
 			Player& player, int& stars,
 			SoundBufferHolder& sfx, MusicHolder& music,
 			bool& menuMusicFlag, bool& sfxFlag,
-			MusicState& musicState);
+			MusicState& musicState, bool& restartFlag, ResourceLoader& loader);
 
 		sf::RenderWindow* window;
 		TextureHolder* textures;
@@ -40,6 +42,8 @@ public:
 		bool* isMusicOn;
 		bool* isSoundOn;
 		MusicState* currentMusic;
+		bool* restartLevel;		// Set by an overlay before it pops; the GameState below resets in place
+		ResourceLoader* loader;
 	};
 
 
@@ -59,8 +63,12 @@ protected:
 
 	Context				getContext() const;
 
+	// For declared textures: keeps them resident for as long as this state lives
+	sf::Texture&		acquireTexture(Textures::ID id);
+
 
 private:
 	StateStack* mStack;
 	Context				mContext;
+	std::vector<TextureHolder::Handle> mTextureHandles;
 };
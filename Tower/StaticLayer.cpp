@@ -0,0 +1,55 @@
+#include "StaticLayer.h"
+#include <stdexcept>
+
+StaticLayer::StaticLayer()
+    : mQuad(sf::TriangleStrip, sf::VertexBuffer::Static)
+    , mDirty(true)
+{
+}
+
+void StaticLayer::create(sf::Vector2u size)
+{
+    mDirty = true;
+    if (mTexture.getSize() == size)
+        return;
+
+    if (!mTexture.create(size.x, size.y))
+        throw std::runtime_error("StaticLayer::create - Failed to create render texture");
+    mSprite.setTexture(mTexture.getTexture(), true);
+
+    if (sf::VertexBuffer::isAvailable() && mQuad.create(4))
+    {
+        float w = (float)size.x, h = (float)size.y;
+        sf::Vertex quad[4] = {
+            sf::Vertex(sf::Vector2f(0.f, 0.f), sf::Vector2f(0.f, 0.f)),
+            sf::Vertex(sf::Vector2f(0.f, h), sf::Vector2f(0.f, h)),
+            sf::Vertex(sf::Vector2f(w, 0.f), sf::Vector2f(w, 0.f)),
+            sf::Vertex(sf::Vector2f(w, h), sf::Vector2f(w, h))
+        };
+        mQuad.update(quad);
+    }
+}
+
+sf::RenderTarget& StaticLayer::begin()
+{
+    mTexture.clear(sf::Color::Transparent);
+    return mTexture;
+}
+
+void StaticLayer::end()
+{
+    mTexture.display();
+    mDirty = false;
+}
+
+void StaticLayer::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+    if (mQuad.getVertexCount() == 0)
+    {
+        target.draw(mSprite, states);
+        return;
+    }
+
+    states.texture = &mTexture.getTexture();
+    target.draw(mQuad, states);
+}
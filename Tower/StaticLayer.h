@@ -0,0 +1,29 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+
+// Content that rarely changes, composited once into an off-screen texture
+// and blitted with a single draw per frame. The owner calls invalidate()
+// when something in it changes; the next frame redraws it through
+// begin()/end() before drawing. The blit quad itself sits in a Static GPU
+// buffer, uploaded once when the layer is created.
+class StaticLayer
+{
+public:
+    StaticLayer();
+
+    void create(sf::Vector2u size); // Keeps the current texture if the size matches
+
+    void invalidate() { mDirty = true; }
+    bool isDirty() const { return mDirty; }
+
+    sf::RenderTarget& begin(); // Cleared target to redraw the layer into
+    void end();
+
+    void draw(sf::RenderTarget& target, sf::RenderStates states = sf::RenderStates::Default) const;
+
+private:
+    sf::RenderTexture mTexture;
+    sf::VertexBuffer mQuad;
+    sf::Sprite mSprite; // Used when vertex buffers are not supported
+    bool mDirty;
+};
@@ -0,0 +1,239 @@
+#include "TextureAtlas.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+void TextureRegion::applyTo(sf::Sprite& sprite) const
+{
+    sprite.setTexture(*texture);
+    sprite.setTextureRect(rect);
+}
+
+sf::Vector2i TextureRegion::toTexels(int width, int height) const
+{
+    return sf::Vector2i((int)std::lround(width * scale.x), (int)std::lround(height * scale.y));
+}
+
+sf::Vector2f TextureRegion::spriteScale(float drawScaleX, float drawScaleY) const
+{
+    return sf::Vector2f(drawScaleX / scale.x, drawScaleY / scale.y);
+}
+
+namespace
+{
+    struct Texel
+    {
+        float r, g, b, a; // Color premultiplied by alpha
+    };
+
+    // One axis of a box filter: every output texel averages the input texels
+    // its footprint covers, weighted by how much of each it covers
+    void boxFilter(const std::vector<Texel>& in, unsigned inLength, std::vector<Texel>& out, unsigned outLength,
+        unsigned lines, unsigned inStride, unsigned inStep, unsigned outStride, unsigned outStep)
+    {
+        float footprint = (float)inLength / outLength;
+        for (unsigned line = 0; line < lines; ++line)
+        {
+            for (unsigned o = 0; o < outLength; ++o)
+            {
+                float begin = o * footprint, end = begin + footprint;
+                Texel sum = { 0.f, 0.f, 0.f, 0.f };
+                for (unsigned i = (unsigned)begin; i < inLength && i < end; ++i)
+                {
+                    float weight = std::min(end, i + 1.f) - std::max(begin, (float)i);
+                    const Texel& t = in[line * inStride + i * inStep];
+                    sum.r += t.r * weight;
+                    sum.g += t.g * weight;
+                    sum.b += t.b * weight;
+                    sum.a += t.a * weight;
+                }
+                Texel& result = out[line * outStride + o * outStep];
+                result = { sum.r / footprint, sum.g / footprint, sum.b / footprint, sum.a / footprint };
+            }
+        }
+    }
+}
+
+sf::Vector2u SheetFormat::getReserve(sf::Vector2f scale) const
+{
+    if (scale != sf::Vector2f(1.f, 1.f))
+        return sf::Vector2u();
+    return sf::Vector2u(frameSize.x * frameCount.x, frameSize.y * frameCount.y);
+}
+
+sf::Vector2f downscaleSheet(sf::Image& image, const SheetFormat& format)
+{
+    sf::Vector2u source = image.getSize();
+    sf::Vector2u frame = format.frameSize;
+    if (frame.x == 0 || frame.y == 0)
+        frame = source;
+    if (format.drawScale >= 1.f || frame.x == 0 || frame.y == 0)
+        return sf::Vector2f(1.f, 1.f);
+
+    sf::Vector2u target((unsigned)std::ceil(frame.x * format.drawScale), (unsigned)std::ceil(frame.y * format.drawScale));
+    target.x = std::max(target.x, 1u);
+    target.y = std::max(target.y, 1u);
+
+    sf::Image result;
+    result.create(target.x * format.frameCount.x, target.y * format.frameCount.y, sf::Color::Transparent);
+
+    std::vector<Texel> cell(frame.x * frame.y), rows(target.x * frame.y), filtered(target.x * target.y);
+    for (unsigned row = 0; row < format.frameCount.y; ++row)
+    {
+        for (unsigned col = 0; col < format.frameCount.x; ++col)
+        {
+            // Premultiply so transparent texels do not darken the edges they are averaged into
+            for (unsigned y = 0; y < frame.y; ++y)
+            {
+                for (unsigned x = 0; x < frame.x; ++x)
+                {
+                    unsigned sx = col * frame.x + x, sy = row * frame.y + y;
+                    sf::Color c = (sx < source.x && sy < source.y) ? image.getPixel(sx, sy) : sf::Color::Transparent;
+                    float a = c.a / 255.f;
+                    cell[y * frame.x + x] = { c.r * a, c.g * a, c.b * a, (float)c.a };
+                }
+            }
+
+            boxFilter(cell, frame.x, rows, target.x, frame.y, frame.x, 1, target.x, 1);
+            boxFilter(rows, frame.y, filtered, target.y, target.x, 1, target.x, 1, target.x);
+
+            for (unsigned y = 0; y < target.y; ++y)
+            {
+                for (unsigned x = 0; x < target.x; ++x)
+                {
+                    const Texel& t = filtered[y * target.x + x];
+                    float a = t.a / 255.f;
+                    sf::Color c = sf::Color::Transparent;
+                    if (a > 0.f)
+                        c = sf::Color((sf::Uint8)std::min(255.f, t.r / a + 0.5f), (sf::Uint8)std::min(255.f, t.g / a + 0.5f),
+                            (sf::Uint8)std::min(255.f, t.b / a + 0.5f), (sf::Uint8)std::min(255.f, t.a + 0.5f));
+                    result.setPixel(col * target.x + x, row * target.y + y, c);
+                }
+            }
+        }
+    }
+
+    image = result;
+    return sf::Vector2f((float)target.x / frame.x, (float)target.y / frame.y);
+}
+
+void TextureAtlas::add(int key, const std::string& filename, sf::Vector2u reserve)
+{
+    sf::Image image;
+    if (!image.loadFromFile(filename))
+        throw std::runtime_error("TextureAtlas::add - Failed to load " + filename);
+
+    add(key, std::move(image), reserve);
+}
+
+void TextureAtlas::add(int key, const std::string& filename, const SheetFormat& format)
+{
+    sf::Image image;
+    if (!image.loadFromFile(filename))
+        throw std::runtime_error("TextureAtlas::add - Failed to load " + filename);
+
+    sf::Vector2f scale = downscaleSheet(image, format);
+    add(key, std::move(image), format.getReserve(scale), scale);
+}
+
+void TextureAtlas::add(int key, sf::Image image, sf::Vector2u reserve, sf::Vector2f scale)
+{
+    Pending p;
+    p.key = key;
+    p.image = std::move(image);
+    p.scale = scale;
+
+    sf::Vector2u size = p.image.getSize();
+    p.cell = sf::Vector2u(std::max(size.x, reserve.x), std::max(size.y, reserve.y));
+    mPending.push_back(std::move(p));
+}
+
+void TextureAtlas::pack(unsigned maxPageSize)
+{
+    struct Placement
+    {
+        std::size_t pending;
+        unsigned x, y;
+    };
+
+    // Tallest first keeps the shelves tight
+    std::vector<std::size_t> order(mPending.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) {
+        return mPending[a].cell.y > mPending[b].cell.y;
+    });
+
+    std::vector<std::vector<Placement>> pages(1);
+    std::vector<sf::Vector2u> pageSizes(1);
+    unsigned x = 0, y = 0, shelfHeight = 0;
+
+    for (std::size_t i : order)
+    {
+        sf::Vector2u cell = mPending[i].cell;
+        unsigned w = cell.x + PADDING, h = cell.y + PADDING;
+
+        // Too big to share a page, give it one of its own ahead of the page being filled
+        if (w > maxPageSize || h > maxPageSize)
+        {
+            pages.insert(pages.end() - 1, std::vector<Placement>(1, Placement{ i, 0, 0 }));
+            pageSizes.insert(pageSizes.end() - 1, mPending[i].image.getSize());
+            continue;
+        }
+
+        if (x + w > maxPageSize)
+        {
+            x = 0;
+            y += shelfHeight;
+            shelfHeight = 0;
+        }
+        if (y + h > maxPageSize)
+        {
+            pages.emplace_back();
+            pageSizes.emplace_back();
+            x = y = shelfHeight = 0;
+        }
+
+        pages.back().push_back({ i, x, y });
+        sf::Vector2u& used = pageSizes.back();
+        used.x = std::max(used.x, x + w);
+        used.y = std::max(used.y, y + h);
+        x += w;
+        shelfHeight = std::max(shelfHeight, h);
+    }
+
+    for (std::size_t p = 0; p < pages.size(); ++p)
+    {
+        if (pages[p].empty())
+            continue;
+
+        sf::Image image;
+        image.create(pageSizes[p].x, pageSizes[p].y, sf::Color::Transparent);
+        for (const Placement& place : pages[p])
+            image.copy(mPending[place.pending].image, place.x, place.y);
+
+        std::unique_ptr<sf::Texture> texture(new sf::Texture());
+        if (!texture->loadFromImage(image))
+            throw std::runtime_error("TextureAtlas::pack - Failed to create page texture");
+
+        for (const Placement& place : pages[p])
+        {
+            const Pending& pending = mPending[place.pending];
+            sf::Vector2u size = pending.image.getSize();
+            TextureRegion region;
+            region.texture = texture.get();
+            region.rect = sf::IntRect((int)place.x, (int)place.y, (int)size.x, (int)size.y);
+            region.scale = pending.scale;
+            mRegions[pending.key] = region;
+        }
+        mPages.push_back(std::move(texture));
+    }
+
+    mPending.clear();
+}
+
+const TextureRegion* TextureAtlas::find(int key) const
+{
+    auto found = mRegions.find(key);
+    return found != mRegions.end() ? &found->second : nullptr;
+}
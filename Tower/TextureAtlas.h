@@ -0,0 +1,75 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// A sub-rectangle of a texture. Sprites set both, so one can come from an
+// atlas page or be a whole standalone texture without the caller knowing.
+struct TextureRegion
+{
+    const sf::Texture* texture = nullptr;
+    sf::IntRect rect;
+    sf::Vector2f scale = sf::Vector2f(1.f, 1.f); // Stored texels per authored pixel, below 1 once downscaled
+
+    void applyTo(sf::Sprite& sprite) const;
+
+    // Authored frame size to texels in this region, and the sprite scale
+    // that draws it at the authored drawScale
+    sf::Vector2i toTexels(int width, int height) const;
+    sf::Vector2f spriteScale(float drawScaleX, float drawScaleY) const;
+};
+
+// Frame grid of a sprite sheet in authored pixels, and the largest scale any
+// sprite draws it at. A zero frameSize means the whole image is one frame.
+struct SheetFormat
+{
+    sf::Vector2u frameSize;
+    sf::Vector2u frameCount = sf::Vector2u(1, 1); // Columns, rows
+    float drawScale = 1.f;
+
+    // Atlas cell to reserve once downscaleSheet() returned scale: a resampled
+    // sheet covers its grid exactly, an untouched one may overhang its image
+    sf::Vector2u getReserve(sf::Vector2f scale) const;
+};
+
+// Resamples a sheet drawn below its native size down to drawScale. Every
+// frame is box filtered on its own to a whole number of texels, so frame
+// edges stay on the grid and never bleed into a neighbour; frames that
+// overhang the image read transparent. Returns the texels per authored pixel
+// actually used, (1, 1) when the sheet is left untouched.
+sf::Vector2f downscaleSheet(sf::Image& image, const SheetFormat& format);
+
+// Packs many small images into a few large pages with a shelf packer, so
+// sprites that use different images still share a texture and can be
+// batched together.
+class TextureAtlas
+{
+public:
+    static const unsigned PADDING = 2; // Transparent gap between images
+
+    // Queue an image for the next pack(). reserve is the minimum cell size:
+    // sheets whose frame grid runs past the image edge reserve the whole
+    // grid, so overhanging frames read transparent pixels and not a neighbour.
+    void add(int key, const std::string& filename, sf::Vector2u reserve = sf::Vector2u());
+    void add(int key, const std::string& filename, const SheetFormat& format); // Downscaled to format.drawScale
+    void add(int key, sf::Image image, sf::Vector2u reserve, sf::Vector2f scale = sf::Vector2f(1.f, 1.f)); // Already decoded
+    void pack(unsigned maxPageSize);
+
+    const TextureRegion* find(int key) const;
+    std::size_t getPageCount() const { return mPages.size(); }
+
+private:
+    struct Pending
+    {
+        int key;
+        sf::Image image;
+        sf::Vector2u cell;
+        sf::Vector2f scale;
+    };
+
+    std::vector<Pending> mPending;
+    std::vector<std::unique_ptr<sf::Texture>> mPages; // Regions keep pointers into these
+    std::map<int, TextureRegion> mRegions;
+};
@@ -0,0 +1,18 @@
+#include "ViewCuller.h"
+
+void ViewCuller::setView(const sf::View& view)
+{
+    sf::Vector2f size = view.getSize();
+    mArea = sf::FloatRect(view.getCenter() - size / 2.f, size);
+}
+
+bool ViewCuller::isVisible(sf::Vector2f center, float radius) const
+{
+    return center.x + radius >= mArea.left && center.x - radius <= mArea.left + mArea.width
+        && center.y + radius >= mArea.top && center.y - radius <= mArea.top + mArea.height;
+}
+
+bool ViewCuller::isVisible(const sf::FloatRect& bounds) const
+{
+    return mArea.intersects(bounds);
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+
+// Visibility test against the area a view shows. Entities are tested by a
+// bounding circle so culling needs no sprite transform.
+class ViewCuller
+{
+public:
+    void setView(const sf::View& view); // Rotation is ignored, the game never rotates its views
+
+    bool isVisible(sf::Vector2f center, float radius) const;
+    bool isVisible(const sf::FloatRect& bounds) const;
+
+private:
+    sf::FloatRect mArea;
+};
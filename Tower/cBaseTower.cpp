@@ -6,7 +6,7 @@ cBaseTower::cBaseTower() :
     maxHealth(20),
     currentHealth(maxHealth),
     mRecentlyDamaged(false),
-    position(0, 0, 0)
+    position(0, 0)
 {
     // Initialize health bars
     setHealthBarSize(100.f, 10.f);
@@ -66,7 +66,7 @@ void cBaseTower::setTexture(const sf::Texture& texture) {
 
 void cBaseTower::setPosition(int row, int col) {
     // Set grid-based position and update sprite/health bar placement
-    position = cpoint(row, col, 0);
+    position = cpoint(row, col);
     updateSpritePosition();
 }
 
@@ -96,9 +96,10 @@ void cBaseTower::setHealthBarSize(float width, float height) {
     updateSpritePosition(); // Reposition with new size
 }
 
-void cBaseTower::drawHealthBar(sf::RenderWindow& window) const {
-    window.draw(healthBarBackground);
-    window.draw(healthBarFill);
+void cBaseTower::addHealthBar(HealthBarBatch& bars) const {
+    sf::FloatRect area(healthBarBackground.getPosition(), healthBarBackground.getSize());
+    float percent = area.width > 0.f ? healthBarFill.getSize().x / area.width : 0.f;
+    bars.add(area, percent, healthBarBackground.getFillColor(), healthBarFill.getFillColor());
 }
 
 void cBaseTower::updateSpritePosition() {
@@ -1 +1 @@
-#pragma once#include <SFML/Graphics.hpp>#include "cpoint.h"class cBaseTower {private:    int maxHealth;    int currentHealth;    sf::Sprite sprite;    cpoint position;    float scale;    sf::Clock mDamageTimer;    bool mRecentlyDamaged;    // Health bar members (only declare once)    sf::RectangleShape healthBarBackground;    sf::RectangleShape healthBarFill;public:    cBaseTower();    cBaseTower(int row, int col);    void takeDamage(int damage);    void heal(int amount);    bool isDestroyed() const;    bool recentlyDamaged() const;    // Getter    int getHealth() const { return currentHealth; }    int getMaxHealth() const { return maxHealth; }    sf::Sprite& getSprite() { return sprite; }    const sf::Sprite& getSprite() const { return sprite; }    const cpoint& getPosition() const { return position; }    // Setter    void setTexture(const sf::Texture& texture);    void setPosition(int row, int col);    void setPixelPosition(float x, float y);    void setHealth(int hp);    void setMaxHealh(int hp);    void setCurrentHealth(int curHP);    void setHealthBarSize(float width, float height);    // For visual health display    void drawHealthBar(sf::RenderWindow& window) const;private:    void updateSpritePosition();};
\ No newline at end of file
+#pragma once#include <SFML/Graphics.hpp>#include "cpoint.h"#include "HealthBarBatch.h"class cBaseTower {private:    int maxHealth;    int currentHealth;    sf::Sprite sprite;    cpoint position;    float scale;    sf::Clock mDamageTimer;    bool mRecentlyDamaged;    // Health bar members (only declare once)    sf::RectangleShape healthBarBackground;    sf::RectangleShape healthBarFill;public:    cBaseTower();    cBaseTower(int row, int col);    void takeDamage(int damage);    void heal(int amount);    bool isDestroyed() const;    bool recentlyDamaged() const;    // Getter    int getHealth() const { return currentHealth; }    int getMaxHealth() const { return maxHealth; }    sf::Sprite& getSprite() { return sprite; }    const sf::Sprite& getSprite() const { return sprite; }    const cpoint& getPosition() const { return position; }    // Setter    void setTexture(const sf::Texture& texture);    void setPosition(int row, int col);    void setPixelPosition(float x, float y);    void setHealth(int hp);    void setMaxHealh(int hp);    void setCurrentHealth(int curHP);    void setHealthBarSize(float width, float height);    // For visual health display    void addHealthBar(HealthBarBatch& bars) const;private:    void updateSpritePosition();};
\ No newline at end of file
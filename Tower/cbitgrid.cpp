@@ -0,0 +1,238 @@
+#include "cbitgrid.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace
+{
+    int lowestBit(uint64_t x) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, x);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(x);
+#endif
+    }
+
+    int bitCount(uint64_t x) {
+#ifdef _MSC_VER
+        return static_cast<int>(__popcnt64(x));
+#else
+        return __builtin_popcountll(x);
+#endif
+    }
+
+    uint64_t reverseBits(uint64_t x) {
+        x = ((x >> 1) & 0x5555555555555555ull) | ((x & 0x5555555555555555ull) << 1);
+        x = ((x >> 2) & 0x3333333333333333ull) | ((x & 0x3333333333333333ull) << 2);
+        x = ((x >> 4) & 0x0F0F0F0F0F0F0F0Full) | ((x & 0x0F0F0F0F0F0F0F0Full) << 4);
+        x = ((x >> 8) & 0x00FF00FF00FF00FFull) | ((x & 0x00FF00FF00FF00FFull) << 8);
+        x = ((x >> 16) & 0x0000FFFF0000FFFFull) | ((x & 0x0000FFFF0000FFFFull) << 16);
+        return (x >> 32) | (x << 32);
+    }
+
+    // Set bits run from seed upward to the end of its run of ones in w
+    uint64_t fillUp(uint64_t w, uint64_t seeds) {
+        return (((w + seeds) ^ w) & w) | seeds;
+    }
+
+    bool inside(const cpoint& p) {
+        return p.getRow() >= 0 && p.getRow() < cpoint::MAP_ROW && p.getCol() >= 0 && p.getCol() < cpoint::MAP_COL;
+    }
+}
+
+cbitgrid::cbitgrid() {
+    clear();
+}
+
+void cbitgrid::clear() {
+    for (int i = 0; i < cpoint::MAP_ROW; i++)
+        _rows[i] = 0;
+}
+
+void cbitgrid::set(int row, int col, bool value) {
+    if (value)
+        _rows[row] |= Row(1) << col;
+    else
+        _rows[row] &= ~(Row(1) << col);
+}
+
+bool cbitgrid::test(int row, int col) const {
+    if (row < 0 || row >= cpoint::MAP_ROW || col < 0 || col >= cpoint::MAP_COL)
+        return false;
+    return (_rows[row] >> col) & 1;
+}
+
+int cbitgrid::count() const {
+    int n = 0;
+    for (int i = 0; i < cpoint::MAP_ROW; i++)
+        n += bitCount(_rows[i]);
+    return n;
+}
+
+// 4-neighbours of a whole frontier row: left/right by shifting, up/down from adjacent rows
+cbitgrid::Row cbitgrid::expand(const Row* frontier, int row) {
+    Row n = (frontier[row] << 1) | (frontier[row] >> 1);
+    if (row > 0) n |= frontier[row - 1];
+    if (row < cpoint::MAP_ROW - 1) n |= frontier[row + 1];
+    return n & COL_MASK;
+}
+
+// Grow every seed over the full run of walkable tiles it sits in, in both directions
+cbitgrid::Row cbitgrid::fillRuns(Row walkable, Row seeds) {
+    seeds &= walkable;
+    Row up = fillUp(walkable, seeds);
+    Row down = reverseBits(fillUp(reverseBits(walkable), reverseBits(seeds)));
+    return up | down;
+}
+
+cbitgrid cbitgrid::floodFill(const cpoint& s) const {
+    cbitgrid r;
+    if (!inside(s)) return r;
+
+    r._rows[s.getRow()] = Row(1) << s.getCol();
+
+    // Alternate top-down and bottom-up sweeps until nothing changes; each row fill
+    // covers a whole horizontal corridor at once, so corridors cost one step
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int pass = 0; pass < 2; pass++) {
+            for (int k = 0; k < cpoint::MAP_ROW; k++) {
+                int i = pass == 0 ? k : cpoint::MAP_ROW - 1 - k;
+                Row filled = r._rows[i] | fillRuns(_rows[i], expand(r._rows, i) | r._rows[i]);
+                if (filled != r._rows[i]) {
+                    r._rows[i] = filled;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    // Start tile only counts when it is itself set
+    if (!test(s.getRow(), s.getCol()))
+        r.set(s.getRow(), s.getCol(), false);
+    return r;
+}
+
+bool cbitgrid::isReachable(const cpoint& s, const cpoint& e) const {
+    return distance(s, e) != UNREACHABLE;
+}
+
+int cbitgrid::distance(const cpoint& s, const cpoint& e) const {
+    if (!inside(s) || !inside(e)) return UNREACHABLE;
+    if (s.getRow() == e.getRow() && s.getCol() == e.getCol()) return 0;
+    if (!test(e.getRow(), e.getCol())) return UNREACHABLE;
+
+    Row visited[cpoint::MAP_ROW] = {};
+    Row bufA[cpoint::MAP_ROW] = {};
+    Row bufB[cpoint::MAP_ROW] = {};
+    Row* frontier = bufA;
+    Row* next = bufB;
+    Row goal = Row(1) << e.getCol();
+
+    visited[s.getRow()] = frontier[s.getRow()] = Row(1) << s.getCol();
+    int lo = s.getRow(), hi = s.getRow();
+
+    for (int d = 1; ; d++) {
+        int from = lo > 0 ? lo - 1 : 0;
+        int to = hi < cpoint::MAP_ROW - 1 ? hi + 1 : hi;
+        int newLo = cpoint::MAP_ROW, newHi = -1;
+
+        for (int i = from; i <= to; i++) {
+            next[i] = expand(frontier, i) & _rows[i] & ~visited[i];
+            if (next[i]) {
+                if (i < newLo) newLo = i;
+                newHi = i;
+            }
+        }
+        if (newHi < 0) return UNREACHABLE;
+        if (next[e.getRow()] & goal) return d;
+
+        for (int i = lo; i <= hi; i++) frontier[i] = 0;
+        for (int i = newLo; i <= newHi; i++) visited[i] |= next[i];
+        Row* t = frontier; frontier = next; next = t;
+        lo = newLo;
+        hi = newHi;
+    }
+}
+
+void cbitgrid::distanceField(const cpoint& s, int16_t dist[][cpoint::MAP_COL]) const {
+    for (int i = 0; i < cpoint::MAP_ROW; i++)
+        for (int j = 0; j < cpoint::MAP_COL; j++)
+            dist[i][j] = UNREACHABLE;
+    if (!inside(s)) return;
+
+    Row visited[cpoint::MAP_ROW] = {};
+    Row bufA[cpoint::MAP_ROW] = {};
+    Row bufB[cpoint::MAP_ROW] = {};
+    Row* frontier = bufA;
+    Row* next = bufB;
+
+    visited[s.getRow()] = frontier[s.getRow()] = Row(1) << s.getCol();
+    dist[s.getRow()][s.getCol()] = 0;
+    int lo = s.getRow(), hi = s.getRow();
+
+    // Only the rows around the current frontier are touched, so a long corridor
+    // costs a handful of word operations per layer instead of a full sweep
+    for (int16_t d = 1; ; d++) {
+        int from = lo > 0 ? lo - 1 : 0;
+        int to = hi < cpoint::MAP_ROW - 1 ? hi + 1 : hi;
+        int newLo = cpoint::MAP_ROW, newHi = -1;
+
+        for (int i = from; i <= to; i++) {
+            next[i] = expand(frontier, i) & _rows[i] & ~visited[i];
+            if (next[i]) {
+                if (i < newLo) newLo = i;
+                newHi = i;
+                // Only newly reached tiles are written, so every tile is touched once
+                for (Row bits = next[i]; bits; bits &= bits - 1)
+                    dist[i][lowestBit(bits)] = d;
+            }
+        }
+        if (newHi < 0) return;
+
+        for (int i = lo; i <= hi; i++) frontier[i] = 0;
+        for (int i = newLo; i <= newHi; i++) visited[i] |= next[i];
+        Row* t = frontier; frontier = next; next = t;
+        lo = newLo;
+        hi = newHi;
+    }
+}
+
+int cbitgrid::shortestPath(const cpoint& s, const cpoint& e, cpoint* out, int capacity) const {
+    if (!inside(s) || !inside(e)) return 0;
+
+    // The field spreads out of e whether or not it is set, a path may not end there
+    bool same = s.getRow() == e.getRow() && s.getCol() == e.getCol();
+    if (!same && !test(e.getRow(), e.getCol())) return 0;
+
+    // Word-parallel distance field from the goal, then walk down it from the start
+    int16_t dist[cpoint::MAP_ROW][cpoint::MAP_COL];
+    distanceField(e, dist);
+
+    int d = dist[s.getRow()][s.getCol()];
+    if (d == UNREACHABLE || d + 1 > capacity) return 0;
+
+    // Ties are broken by trying up, left, down, right at every step, so the
+    // route only depends on the grid. The level compiler bakes it, which pins it
+    static const int dr[4] = { -1, 0, 1, 0 };
+    static const int dc[4] = { 0, -1, 0, 1 };
+
+    int row = s.getRow(), col = s.getCol();
+    out[0] = s;
+    for (int k = 1; k <= d; k++) {
+        for (int i = 0; i < 4; i++) {
+            int r = row + dr[i], c = col + dc[i];
+            if (r >= 0 && r < cpoint::MAP_ROW && c >= 0 && c < cpoint::MAP_COL && dist[r][c] == d - k) {
+                row = r;
+                col = c;
+                break;
+            }
+        }
+        out[k] = cpoint(row, col);
+    }
+    return d + 1;
+}
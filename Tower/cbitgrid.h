@@ -0,0 +1,45 @@
+#pragma once
+#include "cpoint.h"
+#include <cstdint>
+
+// One bit per tile, one 64-bit word per map row (bit i = column i).
+// Whole rows are expanded at once with shifts and masks, so a full BFS layer
+// costs MAP_ROW word operations and the grid itself fits in 216 bytes.
+// Built into the LevelCompiler, which bakes routes and distance fields with it.
+class cbitgrid
+{
+public:
+    typedef uint64_t Row;
+    static const Row COL_MASK = (Row(1) << cpoint::MAP_COL) - 1;
+    static const int UNREACHABLE = -1;
+
+private:
+    Row _rows[cpoint::MAP_ROW];
+
+public:
+    cbitgrid();
+
+    void clear();
+    void set(int row, int col, bool value);
+    bool test(int row, int col) const;
+    Row getRow(int row) const { return _rows[row]; }
+    int count() const;
+
+    // Every tile reachable from s through set tiles (s included if set)
+    cbitgrid floodFill(const cpoint& s) const;
+    bool isReachable(const cpoint& s, const cpoint& e) const;
+
+    // Number of 4-neighbour steps from s to e, UNREACHABLE if none
+    int distance(const cpoint& s, const cpoint& e) const;
+
+    // Step distance of every tile from s, UNREACHABLE for tiles that cannot be reached
+    void distanceField(const cpoint& s, int16_t dist[][cpoint::MAP_COL]) const;
+
+    // Shortest path s -> e through set tiles (s and e included, both set) written
+    // into out, returns its length or 0. Ties prefer up, left, down, right
+    int shortestPath(const cpoint& s, const cpoint& e, cpoint* out, int capacity) const;
+
+private:
+    static Row expand(const Row* frontier, int row);
+    static Row fillRuns(Row walkable, Row seeds);
+};
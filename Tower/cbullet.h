@@ -1,14 +1,16 @@
 #pragma once
 #include "cpoint.h"
+#include "ctilegrid.h"
 #include "cenemy.h" 
 #include <SFML/Graphics.hpp>
 #include "FrameAnimator.h"
+#include "TextureAtlas.h"
 
 class cbullet
 {
     // Position
     cpoint _p[cpoint::MAP_ROW * cpoint::MAP_COL];
-    cpoint _m[cpoint::MAP_ROW][cpoint::MAP_COL];
+    const ctilegrid* _tiles; // Map the bullet flies over, owned by cmap
     cpoint _curr;
 
     // Stats
@@ -17,21 +19,17 @@ class cbullet
     bool _active;
     int _targetIdx;
     int _damage;
+    int _impactEffect; // EffectSystem kind spawned where the bullet hits, -1 for none
 
     // Animation for bullet
     sf::Sprite _sprite;
     FrameAnimator _anim;
 
-    // Animation for collision effect
-    sf::Sprite _collisionSprite;
-    FrameAnimator _collisionAnim;
-    bool _collisionPlaying = false;
-
 public:
     cbullet();
 
-    // Update internal copy of map for bullet path calculations
-    void updateMap(cpoint map[][cpoint::MAP_COL]);
+    // Map used for bullet path calculations (not copied)
+    void updateMap(const ctilegrid& tiles) { _tiles = &tiles; }
 
     // Getter
     cpoint getCurr() const { return _curr; }
@@ -42,6 +40,7 @@ public:
     float getY() const { return _posY; }
     int getTargetIdx() const { return _targetIdx; }
     int getDamage() const { return _damage; }
+    int getImpactEffect() const { return _impactEffect; }
     const sf::Sprite& getSprite() const { return _sprite; }
 
     // Setter
@@ -51,8 +50,8 @@ public:
     void setPosition(float x, float y);
     void setTargetIdx(int idx) { _targetIdx = idx; }
     void setDamage(int dmg) { _damage = dmg; }
+    void setImpactEffect(int effect) { _impactEffect = effect; }
 
-    int queryCFromRowCol(int row, int col) const;
     int calcPathBullet(const cpoint& tower);
 
     // Collision detection
@@ -62,7 +61,7 @@ public:
     void trackEnemy(const cenemy& enemy, float deltaTime);
 
     // Position and movement
-    void init(const sf::Texture& tex, float x, float y, int frameWidth, int frameHeight, int totalFrames, float animSpeed, float scale);
+    void init(const TextureRegion& sheet, float x, float y, int frameWidth, int frameHeight, int totalFrames, float animSpeed, float scale);
     void updateAnimation(float deltaTime);
     void updateSprite();
     void move(float dx, float dy);
@@ -70,13 +69,5 @@ public:
     // Bullet state management
     bool isActive() const { return _active; } // Returns true if the bullet is still active (on screen, valid target), used to skip deactivated bullets.
     void deactivate() { _active = false; } // Marks the bullet as inactive after hitting an enemy or going off - screen, Prevents further updates or rendering.
-
-    // Animation for collision effect
-    const sf::Sprite& getCollisionSprite() const { return _collisionSprite; }
-    bool isCollisionPlaying() const { return _collisionPlaying; }
-    bool isRemovable() const { return !_active && !_collisionPlaying; } // safe to erase
-    void initCollisionEffect(const sf::Texture& tex, int frameWidth, int frameHeight, int totalFrames, float animSpeed, float scale);
-    void triggerCollision(float x, float y);
-    void updateCollisionEffectAnimation(float deltaTime);
-    void updateCollision(float deltaTime);
+    bool isRemovable() const { return !_active; } // The impact plays in the EffectSystem, a spent bullet is erased at once
 };
@@ -1,7 +1,9 @@
 #pragma once
 #include "cpoint.h"
+#include "cpath.h"
 #include <SFML/Graphics.hpp>
 #include "FrameAnimator.h"
+#include "TextureAtlas.h"
 
 using namespace sf;
 
@@ -9,9 +11,9 @@ enum EnemyState { WALK, ATTACK, DEATH };
 enum EnemyType { FAST_SCOUT = 0, RANGED_MECH = 1, HEAVY_WALKER = 2 };
 
 struct EnemyAnimationData {
-    const Texture* walkTex;
-    const Texture* attackTex;
-    const Texture* deathTex;
+    TextureRegion walkSheet;
+    TextureRegion attackSheet;
+    TextureRegion deathSheet;
 
     int walkFrames, attackFrames, deathFrames;
     float walkSpeed, attackSpeed, deathSpeed;
@@ -27,16 +29,16 @@ struct EnemyAnimationData {
 class cenemy
 {
 private:
-    // Path finding
+    // Path following
     cpoint _start, _end, _curr;
-    cpoint _p[cpoint::MAP_ROW * cpoint::MAP_COL];
-    int _pathLength;
-    int _currentTarget;
-    int dd[4], dc[4];
+    const cpath* _path;   // Shared route owned by the map
+    float _distance;      // Arc length travelled along _path
+    int _segment;         // Segment of _path holding _distance
 
     // Stats
     int _speed;
     int _health;
+    int _maxHealth; // Health at spawn, wave groups can scale it
     int mReward;
     EnemyType _type;
 
@@ -51,15 +53,20 @@ private:
 
     // Animation
     FrameAnimator _anim;
+    bool _culled;   // Off view: the sprite is left stale until it comes back
+    float _radius;  // Bounding circle around the position, covers the hp bar
     EnemyState _state;
     bool _isDead;
     bool _isAttack;
 
-    // Sprite & textures
+    // Sprite & sheets
     Sprite _sprite;
-    const Texture* _walkTex;
-    const Texture* _attackTex;
-    const Texture* _deathTex;
+    Vector2f _drawScale;  // On-screen scale from the animation data
+    Vector2f _sheetScale; // Texels per authored pixel of the current sheet
+    float _facing;        // 1 as authored, -1 mirrored
+    TextureRegion _walkSheet;
+    TextureRegion _attackSheet;
+    TextureRegion _deathSheet;
 
     // Frames & timing (per sheet)
     int   _walkFrames, _attackFrames, _deathFrames;
@@ -76,21 +83,22 @@ public:
     void init(EnemyType type, float x, float y, int hp, const EnemyAnimationData& data);
 
     // Getters
-    cpoint* getP() { return _p; }
     cpoint getStart() const { return _start; }
     cpoint getEnd() const { return _end; }
     cpoint getCurr() const { return _curr; }
-    int getPathLength() const { return _pathLength; }
+    float getDistance() const { return _distance; } // Progress along the path, larger = closer to the base
     int getSpeed() const { return _speed; }
     int getHealth() const { return _health; }
+    int getMaxHealth() const { return _maxHealth; }
     int getResources() const { return mReward; }
-    int getCurrentTarget() const { return _currentTarget; }
     int getDamage() const { return mDamage; }
     float getX() const { return _posX; }
     float getY() const { return _posY; }
     EnemyState getState() const { return _state; }
     EnemyType getType() const { return _type; }
     const Sprite& getSprite() const { return _sprite; }
+    float getBoundingRadius() const { return _radius; }
+    bool isCulled() const { return _culled; }
     static int getHealthByType(EnemyType type);
     static int getSpeedByType(EnemyType type);
     static int getResourcesByType(EnemyType type);
@@ -103,7 +111,8 @@ public:
     void setEnd(const cpoint& tend) { _end = tend; }
     void setCurr(const cpoint& tcurr) { _curr = tcurr; }
     void setPosition(float x, float y);
-    void setCurrentTarget(int t) { _currentTarget = t; }
+    void setPath(const cpath* path, float distance);
+    void setCulled(bool culled);
     void loadFromData(const EnemyAnimationData& data);
 
     // State checks
@@ -120,10 +129,11 @@ public:
     void updateSprite();
     void updateAnimation(float deltaTime);
     void move(float dx, float dy);
-    void incrementTarget() { _currentTarget++; }
+    bool advance(float deltaTime); // True only on the frame the end of the path is reached
+    sf::Vector2f getHeading() const;
     void reachEnd() { _reachedEnd = true; }
-    void faceLeft(EnemyType type);
-    void faceRight(EnemyType type);
+    void faceLeft();
+    void faceRight();
 
     // Combat
     bool hasFinishedDeathAnim() const { return _isDead; }
@@ -131,9 +141,6 @@ public:
     void triggerAttack();
     void takeDamage(int damage);
 
-    // Pathfinding
-    void findPath(cpoint a[][cpoint::MAP_COL], cpoint s, cpoint e);
-
     // Reward management
     bool hasGivenReward() const { return mRewardGiven; }
     void markRewardGiven() { mRewardGiven = true; }
@@ -143,8 +150,6 @@ public:
     void startAttack();
     void startDeath();
     void refreshOriginByCurrentFrames(int fw, int fh);
-
-private:
-    void calcPath(int a[][cpoint::MAP_COL], int n, cpoint s, cpoint e);
+    void refreshScale(); // Draw scale, facing and sheet resolution into the sprite scale
 };
 
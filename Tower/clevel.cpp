@@ -3,25 +3,30 @@
 
 using namespace std;
 
-clevel::clevel(int levelID, int enemyCount, int waveCount, int towerMaxCount, int startGold) {
+clevel::clevel(int levelID, const LevelFile& file) {
+    const LevelHeader& h = file.header();
     _levelID = levelID;
-    _enemyCount = enemyCount;
-    _waveCount = waveCount;
-    _towerMaxCount = towerMaxCount;
-    _startGold = startGold;
+    _towerMaxCount = h.towerMax;
+    _startGold = h.startGold;
     _currentLevel = 1;
-    _currentWaveIndex = 0; // Initialize wave index
+    _currentWaveIndex = 0;
+    _file = &file;
+
+    _enemyCount = 0;
+    for (int i = 0; i < file.waveCount(); i++)
+        _enemyCount += file.enemyCount(i);
+    _waveCount = file.waveCount();
 }
 
-void clevel::loadMap(sf::Texture* mainTowerTexture, sf::Texture* mapTexture, int levelId) {
+void clevel::loadMap(sf::Texture* mainTowerTexture, sf::Texture* mapTexture) {
     // First validate textures
-    if (!mainTowerTexture || !mapTexture) {
-        cerr << "Error: Null texture passed to loadMap()" << endl;
+    if (!mainTowerTexture || !mapTexture || !_file) {
+        cerr << "Error: Null texture or level passed to loadMap()" << endl;
         return;
     }
 
     // Load map data
-    _map.makeMapData(mainTowerTexture, mapTexture, levelId);
+    _map.makeMapData(mainTowerTexture, mapTexture, *_file);
 
     // Set main tower texture and properties
     if (mainTowerTexture) {
@@ -42,20 +47,13 @@ void clevel::loadMap(sf::Texture* mainTowerTexture, sf::Texture* mapTexture, int
 
         // Set position based on map data
         cpoint towerTile = _map.getMainTowerTile();
-        float towerX = _map.getMap()[towerTile.getRow()][towerTile.getCol()].getPixelX();
-        float towerY = _map.getMap()[towerTile.getRow()][towerTile.getCol()].getPixelY();
+        float towerX = towerTile.getPixelX();
+        float towerY = towerTile.getPixelY();
         mainTower.setPosition(towerX, towerY); // Adjust Y offset as needed
     }
 }
 
 void clevel::nextWave() {
-    if (_currentWaveIndex + 1 < _waves.size())
+    if (_currentWaveIndex + 1 < _waveCount)
         _currentWaveIndex++;
 }
-
-pair<EnemyType, int> clevel::getCurrentWaveInfo() const {
-    if (_currentWaveIndex < _waves.size())
-        return _waves[_currentWaveIndex];
-    else
-        return { HEAVY_WALKER, 0 };
-}
@@ -1,6 +1,7 @@
 #pragma once
 #include "cpoint.h"
 #include "cmap.h"
+#include "LevelFile.h"
 #include <vector>
 #include <string>
 
@@ -15,16 +16,16 @@ private:
 	int _waveCount;
 	int _towerMaxCount;
 	int _startGold;
+	const LevelFile* _file;
 	cmap _map;
-	vector<pair<EnemyType, int>> _waves;
 	int _currentWaveIndex = 0;
 
 	cBaseTower mainTower;
 
 public:
-	clevel(int levelID, int enemyCount, int waveCount, int towerMaxCount, int startGold);
+	clevel(int levelID, const LevelFile& file); // Stats and waves from the level file
 
-	void loadMap(sf::Texture* mainTowerTexture, sf::Texture* mapTexture, int levelId);
+	void loadMap(sf::Texture* mainTowerTexture, sf::Texture* mapTexture);
 	void nextWave();
 
 	// Getters
@@ -35,10 +36,9 @@ public:
 	int getTowerMaxCount() const { return _towerMaxCount; }
 	int getStartGold() const { return _startGold; }
 	cmap& getMap() { return _map; };
-	const vector<std::pair<EnemyType, int>>& getWaves() const { return _waves; }
-	pair<EnemyType, int> getCurrentWaveInfo() const;
+	const LevelFile& getFile() const { return *_file; } // Wave timelines live here, see cspawner
 	int getCurrentWaveIndex() const { return _currentWaveIndex; }
-	bool isLastWave() const { return _currentWaveIndex >= _waves.size() - 1; }
+	bool isLastWave() const { return _currentWaveIndex >= _waveCount - 1; }
 
 	// Setters
 	void setLevelID(int level) { _levelID = level; }
@@ -48,7 +48,6 @@ public:
 	void setTowerMaxCount(int towerMaxCount) { _towerMaxCount = towerMaxCount; }
 	void setStartGold(int startGold) { _startGold = startGold; }
 	void setMap(cmap map) { _map = map; }
-	void setWaves(const vector<pair<EnemyType, int>>& waves) { _waves = waves; }
 	void resetWave() { _currentWaveIndex = 0; }
 	void setCurrentWaveIndex(int curWave) { _currentWaveIndex = curWave; }
 };
@@ -2,23 +2,24 @@
 #include "cenemy.h"
 #include "ctower.h"
 #include "cBaseTower.h"
+#include "ctilegrid.h"
+#include "cpath.h"
+#include "LevelFile.h"
 
-#include "FrameAnimator.h"
+#include "PropLayer.h"
 #include <vector>
 
 using namespace std;
 
-struct PowerStation {
-    sf::Sprite sprite;
-    FrameAnimator animator;
-};
-
 class cmap
 {
 private:
+    const LevelFile* _level; // Mapped level data, owned by GameState
     cenemy _ce;
     ctower _ctw;
-    cpoint _m[cpoint::MAP_ROW][cpoint::MAP_COL];
+    ctilegrid _tiles;
+    cpath _path;         // Enemy route from _ce start to end, shared by every enemy
+    int8_t _slotAt[cpoint::MAP_ROW][cpoint::MAP_COL]; // Tower slot whose footprint holds the tile, -1 if none
 
     // Base Tower properties
     cBaseTower _mainTower;
@@ -28,22 +29,32 @@ private:
     vector <cpoint> _towerBuiltPos;
     vector <bool> _isBuilt;
     sf::Sprite _background;
-    std::vector<PowerStation> _powerStations;
+    PropLayer _props; // Power stations and other ambient animation
 
 public:
     cmap();
 
     void resetMapData();
-    void makeMapData(sf::Texture* mainTowerTexture, sf::Texture* mapTexture, int levelID);
-    void addPowerStation(const sf::Texture& tex, sf::Vector2f pos, int frameW, int frameH, float speed);
-    void loadPowerStationsFromFile(const sf::Texture& tex, const std::string& path, int frameW, int frameH, float speed);
-    void updatePowerStation(float dt);
-    void drawPowerStations(sf::RenderWindow& window);
+    void makeMapData(sf::Texture* mainTowerTexture, sf::Texture* mapTexture, const LevelFile& level);
+    void resetTiles(); // Back to the level's pristine tile flags, undoing every built tower
+    void loadPowerStations(const TextureRegion& sheet, int frameW, int frameH, float speed);
+    void updateProps(float dt);
+    void drawProps(sf::RenderTarget& target) const;
+    void buildSlotGrid();
+    void buildPath();
 
     // Getter
+    const LevelFile& getLevel() const { return *_level; }
+    int getSlotCount() const { return _level->slotCount(); }
+    const LevelSlot& getSlot(int i) const { return _level->slot(i); }
+    int getSlotAt(int row, int col) const {
+        if (row < 0 || row >= cpoint::MAP_ROW || col < 0 || col >= cpoint::MAP_COL) return -1;
+        return _slotAt[row][col];
+    }
     cenemy& getEnemy() { return _ce; }
     ctower& getTower() { return _ctw; }
-    cpoint(&getMap())[cpoint::MAP_ROW][cpoint::MAP_COL]{ return _m; }
+    const ctilegrid& getTiles() const { return _tiles; }
+    const cpath& getPath() const { return _path; }
     sf::Sprite& getBackground() { return _background; }
     cpoint getMainTowerTile() const { return _mainTowerTile; }
     cBaseTower& getMainTower() { return _mainTower; }
@@ -52,4 +63,6 @@ public:
 
     // Setter
     void setMainTowerTile(const cpoint& tilePos);
+    void placeTower(int row, int col, int type);
+    void removeTower(int row, int col);
 };
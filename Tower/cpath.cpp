@@ -0,0 +1,100 @@
+#include "cpath.h"
+#include <algorithm>
+#include <cmath>
+using namespace std;
+
+cpath::cpath() : _end(0.f, 0.f), _length(0.f) {}
+
+void cpath::clear() {
+    _segments.clear();
+    _end = sf::Vector2f(0.f, 0.f);
+    _length = 0.f;
+}
+
+void cpath::build(const cpoint* tiles, int count) {
+    clear();
+    if (count <= 0) return;
+
+    _end = sf::Vector2f((float)tiles[count - 1].getPixelX(), (float)tiles[count - 1].getPixelY());
+
+    // Walk the tiles and start a new segment whenever the step direction changes
+    int first = 0;
+    while (first < count - 1) {
+        int dr = tiles[first + 1].getRow() - tiles[first].getRow();
+        int dc = tiles[first + 1].getCol() - tiles[first].getCol();
+
+        int last = first + 1;
+        while (last < count - 1
+            && tiles[last + 1].getRow() - tiles[last].getRow() == dr
+            && tiles[last + 1].getCol() - tiles[last].getCol() == dc)
+            last++;
+
+        Segment s;
+        s.start = sf::Vector2f((float)tiles[first].getPixelX(), (float)tiles[first].getPixelY());
+        sf::Vector2f to((float)tiles[last].getPixelX(), (float)tiles[last].getPixelY());
+        sf::Vector2f delta = to - s.start;
+        s.length = sqrt(delta.x * delta.x + delta.y * delta.y);
+        s.dir = s.length > 0.f ? delta / s.length : sf::Vector2f(0.f, 0.f);
+        s.offset = _length;
+
+        _segments.push_back(s);
+        _length += s.length;
+        first = last;
+    }
+}
+
+sf::Vector2f cpath::getStart() const {
+    return _segments.empty() ? _end : _segments.front().start;
+}
+
+int cpath::findSegment(float d, int hint) const {
+    int n = (int)_segments.size();
+    if (n == 0) return 0;
+
+    if (hint >= 0 && hint < n && _segments[hint].offset <= d) {
+        while (hint + 1 < n && _segments[hint + 1].offset <= d)
+            hint++;
+        return hint;
+    }
+
+    // Binary search on the segment start offsets
+    auto it = upper_bound(_segments.begin(), _segments.end(), d,
+        [](float value, const Segment& s) { return value < s.offset; });
+    return it == _segments.begin() ? 0 : (int)(it - _segments.begin()) - 1;
+}
+
+sf::Vector2f cpath::positionAt(float d, int segment) const {
+    if (_segments.empty() || d >= _length) return _end;
+
+    const Segment& s = _segments[segment];
+    return s.start + s.dir * (d - s.offset);
+}
+
+void cpath::coverage(sf::Vector2f center, float radius, vector<pair<float, float>>& out) const {
+    out.clear();
+
+    for (int i = 0; i < (int)_segments.size(); i++) {
+        const Segment& s = _segments[i];
+
+        // |start + dir * t - center|^2 <= radius^2, solved for t along the segment
+        sf::Vector2f f = s.start - center;
+        float b = f.x * s.dir.x + f.y * s.dir.y;
+        float c = f.x * f.x + f.y * f.y - radius * radius;
+        float disc = b * b - c;
+        if (disc < 0.f) continue;
+
+        float root = sqrt(disc);
+        float from = -b - root;
+        float to = -b + root;
+        if (i > 0 && from < 0.f) from = 0.f;
+        if (to > s.length) to = s.length;
+        if (from > to) continue;
+
+        from += s.offset;
+        to += s.offset;
+        if (!out.empty() && from <= out.back().second + 0.01f)
+            out.back().second = max(out.back().second, to);
+        else
+            out.push_back(make_pair(from, to));
+    }
+}
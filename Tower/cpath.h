@@ -0,0 +1,52 @@
+#pragma once
+#include "cpoint.h"
+#include <SFML/System/Vector2.hpp>
+#include <utility>
+#include <vector>
+
+// Enemy route compressed into maximal straight segments.
+// Every segment knows the arc length at which it starts, so a position on the
+// path is a pure function of the distance travelled along it.
+class cpath
+{
+public:
+    struct Segment {
+        sf::Vector2f start; // Pixel position where the segment begins
+        sf::Vector2f dir;   // Unit direction
+        float offset;       // Arc length from the path start to this segment
+        float length;
+    };
+
+private:
+    std::vector<Segment> _segments;
+    sf::Vector2f _end;
+    float _length;
+
+public:
+    cpath();
+
+    void clear();
+    // Collapse a tile-by-tile path (as written by cbitgrid::shortestPath) into segments
+    void build(const cpoint* tiles, int count);
+
+    // Getters
+    bool empty() const { return _segments.empty(); }
+    float getLength() const { return _length; }
+    int getSegmentCount() const { return (int)_segments.size(); }
+    const Segment& getSegment(int i) const { return _segments[i]; }
+    sf::Vector2f getStart() const;
+    sf::Vector2f getEnd() const { return _end; }
+
+    // Index of the segment holding distance d. Enemies only move forward, so
+    // starting from their last segment makes this O(1) per frame
+    int findSegment(float d, int hint = 0) const;
+
+    // Pixel position d along the path. Negative d extends back along the first
+    // segment (used to queue enemies off-screen), past the end it clamps
+    sf::Vector2f positionAt(float d, int segment) const;
+    sf::Vector2f positionAt(float d) const { return positionAt(d, findSegment(d)); }
+
+    // Distance intervals [from, to] of the path lying inside the circle, sorted and merged.
+    // The first segment is treated as unbounded backward, like positionAt
+    void coverage(sf::Vector2f center, float radius, std::vector<std::pair<float, float>>& out) const;
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include <cmath>
 
+// Tile coordinate. What the tile holds lives in the map's ctilegrid
 class cpoint
 {
 public:
@@ -9,19 +10,17 @@ public:
     static const int TILE_SIZE = 40;
 
 private:
-    int row, col, c;
+    int row, col;
 
 public:
     cpoint();
-    cpoint(int trow, int tcol, int tc);
+    cpoint(int trow, int tcol);
 
     int getRow() const;
     int getCol() const;
-    int getC() const;
     int getPixelX() const;
     int getPixelY() const;
-    void setC(int tc);
 
-    static cpoint fromXYToRowCol(int x, int y, int c = 0);
-    static cpoint fromRowColToXY(int row, int col, int c = 0);
+    static cpoint fromXYToRowCol(int x, int y);
+    static cpoint fromRowColToXY(int row, int col);
 };
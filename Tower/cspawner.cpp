@@ -0,0 +1,58 @@
+#include "cspawner.h"
+#include <algorithm>
+#include <cmath>
+
+// Default spacing between two enemies of a group, in pixels along the path
+static const float SPAWN_SPACING = 120.f;
+
+static_assert(HEAVY_WALKER + 1 == LevelFile::ENEMY_TYPES, "LevelFile::open accepts a different set of enemy types");
+
+cspawner::cspawner()
+    : _level(nullptr), _firstGroup(0), _groupCount(0), _time(0.f), _remaining(0) {
+}
+
+void cspawner::start(const LevelFile& level, int wave) {
+    const LevelWave& w = level.wave(wave);
+    _level = &level;
+    _firstGroup = (int)w.firstGroup;
+    _groupCount = (int)w.groupCount;
+    _time = 0.f;
+    _spawned.assign(_groupCount, 0);
+    _remaining = level.enemyCount(wave);
+}
+
+void cspawner::stop() {
+    _level = nullptr;
+    _groupCount = 0;
+    _spawned.clear();
+    _remaining = 0;
+}
+
+float cspawner::cadenceOf(const LevelWaveGroup& g) const {
+    if (g.cadence > 0.f)
+        return g.cadence;
+    return SPAWN_SPACING / cenemy::getSpeedByType(static_cast<EnemyType>(g.enemyType));
+}
+
+void cspawner::update(float dt, vector<Spawn>& out) {
+    if (_remaining == 0) return;
+    _time += dt;
+
+    for (int i = 0; i < _groupCount; i++) {
+        const LevelWaveGroup& g = _level->group(_firstGroup + i);
+        EnemyType type = static_cast<EnemyType>(g.enemyType);
+        float cadence = cadenceOf(g);
+        float speed = (float)cenemy::getSpeedByType(type);
+        int health = max(1, (int)lround(cenemy::getHealthByType(type) * g.hpScale));
+
+        // Release everything due by now, placed where it would be had it spawned on time
+        while (_spawned[i] < g.count) {
+            float due = g.delay + _spawned[i] * cadence;
+            if (due > _time) break;
+
+            out.push_back({ type, health, (_time - due) * speed });
+            _spawned[i]++;
+            _remaining--;
+        }
+    }
+}
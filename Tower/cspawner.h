@@ -0,0 +1,40 @@
+#pragma once
+#include "cenemy.h"
+#include "LevelFile.h"
+#include <vector>
+
+using namespace std;
+
+// Plays one wave's group timeline: every tick it hands out only the enemies
+// that have become due, so a wave is never built all at once
+class cspawner
+{
+public:
+    struct Spawn {
+        EnemyType type;
+        int health;
+        float distance; // Path distance already covered since the enemy was due
+    };
+
+private:
+    const LevelFile* _level;
+    int _firstGroup;
+    int _groupCount;
+    float _time;          // Seconds since the wave started
+    vector<int> _spawned; // Enemies handed out per group
+    int _remaining;
+
+    float cadenceOf(const LevelWaveGroup& g) const;
+
+public:
+    cspawner();
+
+    void start(const LevelFile& level, int wave);
+    void stop();
+
+    // Advance the wave clock and append the enemies due by now to out
+    void update(float dt, vector<Spawn>& out);
+
+    bool isDone() const { return _remaining == 0; }
+    int getRemaining() const { return _remaining; }
+};
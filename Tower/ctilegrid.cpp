@@ -0,0 +1,34 @@
+#include "ctilegrid.h"
+
+ctilegrid::ctilegrid() {
+    clear();
+}
+
+void ctilegrid::clear() {
+    for (int i = 0; i < cpoint::MAP_ROW; i++)
+        for (int j = 0; j < cpoint::MAP_COL; j++)
+            _t[i][j] = 0;
+}
+
+void ctilegrid::load(const LevelFile& level) {
+    for (int i = 0; i < cpoint::MAP_ROW; i++)
+        for (int j = 0; j < cpoint::MAP_COL; j++)
+            _t[i][j] = level.tile(i, j) & (WALKABLE | BUILDABLE);
+}
+
+int ctilegrid::getTowerType(int row, int col) const {
+    uint8_t t = get(row, col);
+    if (!(t & TOWER))
+        return -1;
+    return (t & TYPE_MASK) >> TYPE_SHIFT;
+}
+
+void ctilegrid::setTower(int row, int col, int type) {
+    if (!inside(row, col)) return;
+    _t[row][col] = (uint8_t)(TOWER | ((type << TYPE_SHIFT) & TYPE_MASK));
+}
+
+void ctilegrid::clearTower(int row, int col) {
+    if (!inside(row, col)) return;
+    _t[row][col] = BUILDABLE;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include "cpoint.h"
+#include "LevelFile.h"
+#include <cstdint>
+
+// Map tiles packed one byte each: what the tile is (path, free slot, tower)
+// plus the type of the tower standing on it. The whole map is 1.3 KB.
+class ctilegrid
+{
+public:
+    enum Flags : uint8_t {
+        WALKABLE = TILE_WALKABLE,   // Enemy path, same bit as the level file
+        BUILDABLE = TILE_BUILDABLE, // Free tower slot tile, same bit as the level file
+        TOWER = 1 << 2,             // Slot tile holding a tower, see getTowerType
+    };
+    static const int TYPE_SHIFT = 4;
+    static const uint8_t TYPE_MASK = 0x7 << TYPE_SHIFT; // Tower type 0..7
+
+private:
+    uint8_t _t[cpoint::MAP_ROW][cpoint::MAP_COL];
+
+public:
+    ctilegrid();
+
+    void clear();
+    void load(const LevelFile& level); // Pristine walkable / buildable tiles of the level
+
+    static bool inside(int row, int col) {
+        return row >= 0 && row < cpoint::MAP_ROW && col >= 0 && col < cpoint::MAP_COL;
+    }
+
+    // Getters, tiles outside the map are empty
+    uint8_t get(int row, int col) const { return inside(row, col) ? _t[row][col] : 0; }
+    bool isWalkable(int row, int col) const { return (get(row, col) & WALKABLE) != 0; }
+    bool isBuildable(int row, int col) const { return (get(row, col) & BUILDABLE) != 0; }
+    bool hasTower(int row, int col) const { return (get(row, col) & TOWER) != 0; }
+    int getTowerType(int row, int col) const; // -1 if no tower
+
+    // Setters
+    void setTower(int row, int col, int type); // Slot tile now holds a tower of this type
+    void clearTower(int row, int col);         // Back to a free slot tile
+};
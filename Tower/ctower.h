@@ -1,62 +1,68 @@
 #pragma once
 #include "cpoint.h"
 #include "cbullet.h"
+#include "cpath.h"
+#include "LevelFile.h"
 #include <SFML/Graphics.hpp>
-#include "FrameAnimator.h"
+#include "TextureAtlas.h"
 
 using namespace sf;
 using namespace std;
 
+enum TargetMode { TARGET_FIRST, TARGET_LAST, TARGET_STRONGEST };
+
 class ctower {
 private:
     Sprite _sprite;
     cpoint _location;
     cbullet _cb;
     float _shootTimer;
+    bool _flashed; // Muzzle flash of the coming shot already spawned
     int _targetEnemyIdx;
     int _type;
 
+    // Targeting: parts of the enemy path (as path distance) inside the range circle
+    vector<pair<float, float>> _coverage;
+    TargetMode _targetMode;
+
     // MainTower
     Sprite _mainTowerSprite;
     Texture* _mainTowerTexture;
     Vector2f _mainTowerPos;
     int _mainTowerHealth;
 
-    // Animation 
-    Sprite _effectSprite;
-    FrameAnimator _effectAnim;
-    bool _effectPlaying;
-
 public:
     ctower();
 
     int calcPathBullet();
-    void init(const Texture& tex, float x, float y, int index, int itower);
-    void resetShootTimer() { _shootTimer = 0.f; } // Reset the shoot timer to 0 after firing a bullet
+    void init(const TextureRegion& sheet, float x, float y, const LevelSlot& slot);
+    void resetShootTimer() { _shootTimer = 0.f; _flashed = false; } // Reset the shoot timer to 0 after firing a bullet
     void addShootTimer(float dt) { _shootTimer += dt; } // Add delta time to the shoot timer, used to track cooldown between shots
-    void changeOrigin(int index, int itower, const Texture& tex); // UI tower
+    void changeOrigin(const LevelSlot& slot, const TextureRegion& sheet); // UI tower
+    void computeCoverage(const cpath& path, float range); // Call once the tower is placed, towers never move
+    bool covers(float distance) const;
 
-    // shootEffect
-    void initEffect(const Texture& tex, int frameWidth, int frameHeight, int totalFrames, float animSpeed);
-    void startEffect();
-    void updateEffect(float deltaTime);
-    bool isEffectPlaying() const { return _effectPlaying; }
+    // shootEffect, the flash itself plays in the EffectSystem
+    bool hasFlashed() const { return _flashed; }
+    void setFlashed() { _flashed = true; }
 
     // Getter
     int getTargetEnemyIdx() const { return _targetEnemyIdx; }
     int getType() const { return _type; } // Tower 1 = 0 ...
+    TargetMode getTargetMode() const { return _targetMode; }
+    const vector<pair<float, float>>& getCoverage() const { return _coverage; }
     cbullet& getBullet() { return _cb; }
     cpoint getLocation() const { return _location; }
     float getShootTimer() const { return _shootTimer; } // Get the current value of the shoot timer to check if the tower is ready to shoot
     const Sprite& getSprite() const { return _sprite; }
-    const Sprite& getEffectSprite() const { return _effectSprite; }
     const Sprite& getMainTowerSprite() const { return _mainTowerSprite; }
     int getHealth() { return _mainTowerHealth; }
 
     // Setter
     void setTargetEnemyIdx(int idx) { _targetEnemyIdx = idx; }
-    void setMapForBullet(cpoint map[][cpoint::MAP_COL]) { _cb.updateMap(map); }
+    void setMapForBullet(const ctilegrid& tiles) { _cb.updateMap(tiles); }
     void setType(int n) { _type = n; }
+    void setTargetMode(TargetMode mode) { _targetMode = mode; }
     void setLocation(const cpoint& loc) { _location = loc; }
     void setHealth(int health) { _mainTowerHealth = health; }
 };
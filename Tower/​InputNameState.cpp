@@ -1,4 +1,5 @@
 #include "InputNameState.h"
+#include "ResourceLoader.h"
 
 InputNameState::InputNameState(StateStack& stack, Context context)
 	: State(stack, context)
@@ -7,7 +8,9 @@ InputNameState::InputNameState(StateStack& stack, Context context)
 	, invalidInputName()
 	, invalidName(false)
 {
-	Texture& texture = context.textures->get(Textures::inputNameBackground);
+	context.loader->require(Assets::MapSelection);
+
+	Texture& texture = acquireTexture(Textures::inputNameBackground);
 	mBackgroundSprite.setTexture(texture);
 
 	Font& font = context.fonts->get(Fonts::BruceForever);
@@ -9,26 +9,10 @@
 using namespace std;
 
 cbullet::cbullet()
-    : _posX(0.f), _posY(0.f), _speed(4), _active(true), _targetIdx(-1), _damage(1), _n(0)
+    : _tiles(nullptr), _posX(0.f), _posY(0.f), _speed(4), _active(true), _targetIdx(-1), _damage(1), _impactEffect(-1), _n(0)
 {
     for (int i = 0; i < cpoint::MAP_ROW * cpoint::MAP_COL; i++)
-        _p[i] = cpoint(0, 0, 0);
-
-    for (int i = 0; i < cpoint::MAP_ROW; i++)
-        for (int j = 0; j < cpoint::MAP_COL; j++)
-            _m[i][j] = cpoint(0, 0, 0);
-}
-
-void cbullet::updateMap(cpoint map[][cpoint::MAP_COL]) {
-    for (int i = 0; i < cpoint::MAP_ROW; i++)
-        for (int j = 0; j < cpoint::MAP_COL; j++)
-            _m[i][j] = map[i][j];
-}
-
-int cbullet::queryCFromRowCol(int row, int col) const {
-    if (row < 0 || row >= cpoint::MAP_ROW || col < 0 || col >= cpoint::MAP_COL)
-        return -2;
-    return _m[row][col].getC();
+        _p[i] = cpoint(0, 0);
 }
 
 int cbullet::calcPathBullet(const cpoint& tower) {
@@ -36,8 +20,8 @@ int cbullet::calcPathBullet(const cpoint& tower) {
 
     do {
         col++; row--;
-        if (queryCFromRowCol(row, col) == 0) {
-            _p[i] = cpoint(row, col, 0);
+        if (_tiles && _tiles->isWalkable(row, col)) {
+            _p[i] = cpoint(row, col);
             i += 2;
         }
         else break;
@@ -46,7 +30,7 @@ int cbullet::calcPathBullet(const cpoint& tower) {
     _n = i;
 
     for (i = 1; i < _n; i += 2)
-        _p[i] = cpoint(_p[i - 1].getRow(), _p[i - 1].getCol(), 0);
+        _p[i] = cpoint(_p[i - 1].getRow(), _p[i - 1].getCol());
 
     if (_n > 0)
         _curr = _p[0];
@@ -99,66 +83,26 @@ void cbullet::move(float dx, float dy) {
     updateSprite();
 }
 
-void cbullet::init(const sf::Texture& tex, float x, float y, int frameWidth, int frameHeight, int totalFrames, float animSpeed, float scale)
+void cbullet::init(const TextureRegion& sheet, float x, float y, int frameWidth, int frameHeight, int totalFrames, float animSpeed, float scale)
 {
-    _sprite.setTexture(tex);
+    _sprite.setTexture(*sheet.texture);
 
-    _anim.init(frameWidth, frameHeight, animSpeed, totalFrames, /*loop*/ true);
+    // Frame sizes are authored pixels, the sheet may be stored downscaled
+    sf::Vector2i frame = sheet.toTexels(frameWidth, frameHeight);
+    _anim.init(frame.x, frame.y, animSpeed, totalFrames, /*loop*/ true, sf::Vector2i(sheet.rect.left, sheet.rect.top));
     _anim.applyTo(_sprite);
 
-    _sprite.setOrigin(frameWidth / 2.f, frameHeight / 2.f);
-    _sprite.setScale(scale, scale);
+    _sprite.setOrigin(frame.x / 2.f, frame.y / 2.f);
+    _sprite.setScale(sheet.spriteScale(scale, scale));
 
     _posX = x; _posY = y;
     _sprite.setPosition(_posX, _posY);
     _curr = cpoint::fromXYToRowCol(x, y);
 
     _active = true;
-    _collisionPlaying = false;
 }
 
 void cbullet::updateAnimation(float deltaTime) {
     _anim.update(deltaTime);
     _anim.applyTo(_sprite);
 }
-
-void cbullet::initCollisionEffect(const sf::Texture& tex, int frameWidth, int frameHeight, int totalFrames, float animSpeed, float scale)
-{
-    _collisionSprite.setTexture(tex);
-    _collisionSprite.setOrigin(frameWidth * 0.5f, frameHeight * 0.5f);
-    _collisionSprite.setScale(scale, scale);
-
-    _collisionAnim.init(frameWidth, frameHeight, animSpeed, totalFrames, /*loop*/false);
-    _collisionAnim.applyTo(_collisionSprite);
-}
-
-void cbullet::triggerCollision(float x, float y)
-{
-    // Stop bullet, start effect
-    _active = false;
-    _collisionPlaying = true;
-    _collisionAnim.reset();
-    _collisionSprite.setPosition(x, y - 20.f);
-}
-
-void cbullet::updateCollisionEffectAnimation(float deltaTime)
-{
-    // Bullet flying animation
-    if (_active) {
-        _anim.update(deltaTime);
-        _anim.applyTo(_sprite);
-    }
-}
-
-void cbullet::updateCollision(float deltaTime)
-{
-    if (_collisionPlaying) {
-        _collisionAnim.update(deltaTime);
-        _collisionAnim.applyTo(_collisionSprite);
-        if (_collisionAnim.isFinished()) {
-            _collisionPlaying = false;
-            _collisionSprite.setTextureRect({ 0,0,0,0 });
-        }
-    }
-}
-